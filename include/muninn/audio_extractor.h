@@ -1,6 +1,7 @@
 #pragma once
 
 #include "muninn/export.h"
+#include "muninn/audio_stats.h"
 #include <string>
 #include <vector>
 #include <memory>
@@ -53,6 +54,19 @@ public:
      */
     bool extract_track(int track_index, std::vector<float>& samples);
 
+    /**
+     * @brief Extract a track together with its decode-time statistics
+     *
+     * Statistics (peak, RMS, amplitude/level histograms) are accumulated by the
+     * decoder while samples are produced - no extra pass over the audio.
+     *
+     * @param track_index Track index (0-based)
+     * @param samples Output buffer for float32 samples
+     * @param stats Output statistics for the extracted track
+     * @return True if successful
+     */
+    bool extract_track(int track_index, std::vector<float>& samples, AudioStatistics& stats);
+
     /**
      * @brief Extract audio from video/audio file (convenience method - uses track 0)
      *
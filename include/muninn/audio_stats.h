@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace muninn {
+
+/**
+ * @brief Streaming per-track audio statistics
+ *
+ * Accumulated in a single pass while samples are decoded, so track-level
+ * decisions (silent track skip, VAD selection) need no extra scan over the
+ * audio. Percentiles come from fixed-size histograms:
+ * - |amplitude| on a log2 scale, 8 bins per octave (~9% resolution)
+ * - 32ms frame RMS level in 1 dB bins (-120..0 dBFS)
+ *
+ * Example:
+ * @code
+ *   AudioStatistics stats;
+ *   stats.add(samples.data(), samples.size());
+ *   stats.finish();
+ *   if (stats.is_silent()) { ... }
+ *   float noise = stats.amplitude_percentile(0.1f);
+ * @endcode
+ */
+struct AudioStatistics {
+    static constexpr int kBinsPerOctave = 8;
+    static constexpr int kOctaves = 24;                            // 2^-24 .. 1.0
+    static constexpr int kAmplitudeBins = kOctaves * kBinsPerOctave + 1;  // + overflow bin (|x| >= 1)
+    static constexpr int kLevelBins = 121;                         // -120..0 dBFS, 1 dB each
+    static constexpr int kFrameSamples = 512;                      // 32ms at 16kHz
+
+    uint64_t sample_count = 0;
+    uint64_t frame_count = 0;
+    float peak = 0.0f;
+    double sum_squares = 0.0;
+
+    std::array<uint64_t, kAmplitudeBins> amplitude_histogram{};   // Counts of |x| per log2 bin
+    std::array<uint32_t, kLevelBins> level_histogram{};           // Counts of frame RMS per dB bin
+
+    /**
+     * @brief Accumulate a block of samples (any block size, order-preserving)
+     */
+    void add(const float* samples, size_t count);
+
+    /**
+     * @brief Flush the trailing partial frame into the level histogram
+     *
+     * Call once after the last add(). Safe to call more than once.
+     */
+    void finish();
+
+    /**
+     * @brief Reset to the empty state
+     */
+    void reset() { *this = AudioStatistics(); }
+
+    /**
+     * @brief RMS over all samples
+     */
+    float rms() const;
+
+    /**
+     * @brief Estimate the p-th percentile (0.0-1.0) of |amplitude|
+     */
+    float amplitude_percentile(float p) const;
+
+    /**
+     * @brief Estimate the p-th percentile (0.0-1.0) of 32ms frame RMS in dBFS
+     */
+    float level_percentile_db(float p) const;
+
+    /**
+     * @brief True if the track carries no meaningful signal
+     *
+     * @param threshold Peak amplitude below which the track is silent
+     */
+    bool is_silent(float threshold = 0.001f) const { return peak < threshold; }
+
+private:
+    double frame_sum_squares_ = 0.0;
+    int frame_fill_ = 0;
+
+    void add_frame_level(double sum_squares, int count);
+};
+
+} // namespace muninn
@@ -1,16 +1,15 @@
 #pragma once
 
+#include "embedding_ops.h"
 #include "export.h"
+#include "speaker_profiles.h"
 #include "types.h"
+#include "vad.h"
 #include <string>
 #include <vector>
 #include <map>
 #include <memory>
-
-// Only include ONNX Runtime if Silero VAD is enabled
-#ifdef MUNINN_USE_SILERO_VAD
-#include <onnxruntime_cxx_api.h>
-#endif
+#include <future>
 
 namespace muninn {
 
@@ -25,6 +24,37 @@ struct SpeakerEmbedding {
     SpeakerEmbedding() : start(0.0f), end(0.0f) {}
 };
 
+/**
+ * @brief Contiguous speaker-embedding matrix
+ *
+ * Row-major [N, D] floats, one row per analysis window, with the window
+ * times kept in parallel arrays. Batched inference writes straight into it.
+ * Once normalize() has run, rows are unit length and cosine similarity is a
+ * plain dot product (EmbeddingOps::dot / similarity_block).
+ */
+struct EmbeddingMatrix {
+    std::vector<float> data;         // N * dim floats, row-major
+    std::vector<float> starts;       // Window start times in seconds (N)
+    std::vector<float> ends;         // Window end times in seconds (N)
+    size_t dim = 0;                  // Embedding dimension (512 for pyannote)
+    bool normalized = false;         // Rows are L2-normalised
+
+    size_t rows() const { return starts.size(); }
+    bool empty() const { return starts.empty(); }
+    const float* row(size_t i) const { return data.data() + i * dim; }
+    float* row(size_t i) { return data.data() + i * dim; }
+
+    /**
+     * @brief L2-normalise all rows in place (no-op if already normalised)
+     */
+    void normalize() {
+        if (!normalized) {
+            EmbeddingOps::normalize_rows(data.data(), rows(), dim);
+            normalized = true;
+        }
+    }
+};
+
 /**
  * @brief Speaker information
  */
@@ -53,12 +83,17 @@ struct DiarizationOptions {
     float clustering_threshold = 0.7f;     // Cosine similarity threshold (0.5-0.9)
     int min_speakers = 1;                  // Minimum number of speakers
     int max_speakers = 10;                 // Maximum number of speakers (0 = unlimited)
+    int ahc_max_embeddings = 5000;         // Above this, two-stage: k-means pre-clustering, then AHC (0 = always AHC)
+    int kmeans_clusters = 1000;            // Pre-clusters in two-stage mode
+    int kmeans_batch_size = 1024;          // Mini-batch size for k-means updates
+    int kmeans_iterations = 100;           // Mini-batch k-means iterations
 
     // ═══════════════════════════════════════════════════════════
     // Embedding Extraction
     // ═══════════════════════════════════════════════════════════
     float embedding_window_s = 1.0f;       // Window size for embedding extraction (1s = 16000 samples at 16kHz)
     float embedding_step_s = 0.5f;         // Step size between embeddings (50% overlap)
+    int embedding_batch_size = 32;         // Windows per ONNX Run ([B, 16000]); capped by a fixed model batch dim
 
     // ═══════════════════════════════════════════════════════════
     // Speaker Assignment
@@ -66,11 +101,24 @@ struct DiarizationOptions {
     float min_segment_duration = 0.3f;     // Minimum duration to assign speaker
     bool merge_adjacent_same_speaker = true;  // Merge consecutive segments from same speaker
 
+    // ═══════════════════════════════════════════════════════════
+    // Speaker Profiles (cross-file identification)
+    // ═══════════════════════════════════════════════════════════
+    std::string speaker_profiles_path;     // Optional: profile store (.mspk), memory-mapped at init
+    float profile_match_threshold = 0.75f; // Minimum cosine similarity to a profile to use its name
+
+    // ═══════════════════════════════════════════════════════════
+    // Online (Streaming) Mode
+    // ═══════════════════════════════════════════════════════════
+    int online_recluster_interval = 200;   // Re-cluster speaker centroids every N embeddings (0 = never)
+    float online_silence_rms = 0.001f;     // Windows below this RMS are treated as silence (no speaker)
+
     // ═══════════════════════════════════════════════════════════
     // Performance
     // ═══════════════════════════════════════════════════════════
     std::string device = "cuda";           // "cuda" or "cpu"
     int num_threads = 4;                   // CPU threads (if device = "cpu")
+    int num_sessions = 1;                  // Embedding sessions for concurrent diarize() calls (num_threads split between them)
 };
 
 /**
@@ -97,6 +145,47 @@ struct DiarizationResult {
     DiarizationResult() : num_speakers(0) {}
 };
 
+/**
+ * @brief Speaker-embedding model behind a Diarizer
+ *
+ * The default backend is the pyannote ONNX model (a pool of ONNX Runtime
+ * sessions). Other backends - a different runtime, or a deterministic mock
+ * for tests and benchmarks - implement batched inference over fixed-length
+ * windows and are passed to the Diarizer constructor.
+ *
+ * embed() may be called from several threads at once.
+ */
+class MUNINN_API EmbeddingBackend {
+public:
+    virtual ~EmbeddingBackend() = default;
+
+    /**
+     * @brief Samples per window the model expects (shorter windows are zero-padded)
+     */
+    virtual size_t input_samples() const = 0;
+
+    /**
+     * @brief Embedding dimension
+     */
+    virtual size_t dim() const = 0;
+
+    /**
+     * @brief Largest batch accepted per embed() call (0 = unlimited)
+     */
+    virtual size_t max_batch_size() const { return 0; }
+
+    /**
+     * @brief Embed a batch of windows
+     *
+     * @param windows Window pointers (16kHz mono)
+     * @param lengths Samples available in each window
+     * @param count Number of windows
+     * @param output Raw (un-normalised) embeddings, [count, dim()] row-major
+     */
+    virtual void embed(const float* const* windows, const size_t* lengths,
+                       size_t count, float* output) = 0;
+};
+
 /**
  * @brief Speaker Diarization Engine
  *
@@ -129,6 +218,11 @@ struct DiarizationResult {
  *     segment.speaker_label = "Speaker " + std::to_string(speaker);
  * }
  * @endcode
+ *
+ * Threading: diarize() and extract_embedding_matrix() may be called from
+ * several threads at once; with the ONNX backend each call leases sessions
+ * from a pool of options.num_sessions. The online API (push/flush) and
+ * enroll_speaker() are single-threaded.
  */
 class MUNINN_API Diarizer {
 public:
@@ -141,6 +235,15 @@ public:
     Diarizer(const std::string& embedding_model_path,
              const DiarizationOptions& options = DiarizationOptions());
 
+    /**
+     * @brief Initialize diarizer with a custom embedding backend
+     *
+     * @param backend Embedding model (ownership transferred)
+     * @param options Diarization configuration (model path/device ignored)
+     */
+    Diarizer(std::unique_ptr<EmbeddingBackend> backend,
+             const DiarizationOptions& options = DiarizationOptions());
+
     ~Diarizer();
 
     // ═══════════════════════════════════════════════════════════
@@ -159,9 +262,31 @@ public:
                               size_t num_samples,
                               int sample_rate = 16000);
 
+    /**
+     * @brief Perform speaker diarization on the speech portions of audio
+     *
+     * Reuses a VAD timeline (e.g. from transcription) so embeddings are only
+     * extracted inside speech. Speech runs shorter than min_segment_duration
+     * are ignored; runs shorter than one embedding window get a single
+     * window centred on them.
+     *
+     * @param audio_data Audio samples (mono, 16kHz)
+     * @param num_samples Number of audio samples
+     * @param speech_segments Sorted speech segments in seconds (track time)
+     * @param sample_rate Sample rate (must be 16000)
+     * @return DiarizationResult with speaker segments and metadata
+     */
+    DiarizationResult diarize(const float* audio_data,
+                              size_t num_samples,
+                              const std::vector<SpeechSegment>& speech_segments,
+                              int sample_rate = 16000);
+
     /**
      * @brief Get speaker ID at specific time point
      *
+     * O(log n) binary search; expects time-ordered segments as returned by
+     * diarize().
+     *
      * @param result Diarization result
      * @param time_s Time point in seconds
      * @return Speaker ID at that time (-1 if no speaker)
@@ -169,15 +294,39 @@ public:
     static int get_speaker_at_time(const DiarizationResult& result, float time_s);
 
     /**
-     * @brief Assign speakers to transcription segments
+     * @brief Assign speakers to transcription segments and their words
      *
-     * Modifies segments in-place to add speaker_id and speaker_label.
+     * Modifies segments in-place to add speaker_id, speaker_label and
+     * speaker_confidence. Each segment (and each word, if word timestamps
+     * are present) gets the speaker with the largest time overlap, found with
+     * a two-pointer sweep over the time-ordered diarization segments (linear
+     * in the total segment and word count). Confidence is the overlap-weighted
+     * centroid similarity of the matching diarization windows. Words falling
+     * between diarization segments keep the neighbouring word's speaker.
      *
      * @param segments Transcription segments to annotate
      * @param diarization Diarization result
+     * @param track_id Only annotate segments of this track (-1 = all)
      */
     static void assign_speakers_to_segments(std::vector<Segment>& segments,
-                                           const DiarizationResult& diarization);
+                                           const DiarizationResult& diarization,
+                                           int track_id = -1);
+
+    /**
+     * @brief Split segments whose words change speaker
+     *
+     * Run after assign_speakers_to_segments(). Each run of consecutive words
+     * with the same speaker becomes its own segment (text rebuilt from the
+     * words, times from the first/last word). Segments without word
+     * timestamps are left as they are.
+     *
+     * @param segments Transcription segments (replaced in-place, order kept)
+     * @param diarization Diarization result (labels and confidence)
+     * @param track_id Only split segments of this track (-1 = all)
+     */
+    static void split_segments_by_speaker(std::vector<Segment>& segments,
+                                          const DiarizationResult& diarization,
+                                          int track_id = -1);
 
     // ═══════════════════════════════════════════════════════════
     // Embedding Extraction
@@ -204,6 +353,36 @@ public:
                                                      size_t num_samples,
                                                      int sample_rate = 16000);
 
+    /**
+     * @brief Extract sliding-window embeddings into one contiguous matrix
+     *
+     * Windows are taken at fixed strides from the track and sent to the
+     * model as [embedding_batch_size, 16000] batches; outputs are written
+     * directly into the matrix rows, which are then L2-normalised.
+     *
+     * @param audio_data Audio samples (mono, 16kHz)
+     * @param num_samples Number of samples
+     * @param sample_rate Sample rate
+     * @return Embedding matrix [num_windows, embedding_dim] with window times
+     */
+    EmbeddingMatrix extract_embedding_matrix(const float* audio_data,
+                                             size_t num_samples,
+                                             int sample_rate = 16000);
+
+    /**
+     * @brief Extract embeddings only inside speech segments
+     *
+     * @param audio_data Audio samples (mono, 16kHz)
+     * @param num_samples Number of samples
+     * @param speech_segments Sorted speech segments in seconds
+     * @param sample_rate Sample rate
+     * @return Embedding matrix with one row per window inside speech
+     */
+    EmbeddingMatrix extract_embedding_matrix(const float* audio_data,
+                                             size_t num_samples,
+                                             const std::vector<SpeechSegment>& speech_segments,
+                                             int sample_rate = 16000);
+
     // ═══════════════════════════════════════════════════════════
     // Speaker Clustering
     // ═══════════════════════════════════════════════════════════
@@ -218,9 +397,25 @@ public:
      */
     std::vector<Speaker> cluster_speakers(const std::vector<SpeakerEmbedding>& embeddings);
 
+    /**
+     * @brief Cluster embedding rows, returning a cluster label per row
+     *
+     * Average-linkage agglomerative clustering (nearest-neighbour chain,
+     * O(N^2) time, condensed similarity matrix), cut at clustering_threshold
+     * and capped at max_speakers. Above ahc_max_embeddings rows, mini-batch
+     * k-means pre-clusters first and AHC runs on the cluster means.
+     *
+     * @param embeddings Embedding matrix (normalised copy made if needed)
+     * @return Label per row, numbered by first occurrence (0, 1, ...)
+     */
+    std::vector<int> cluster_embeddings(const EmbeddingMatrix& embeddings);
+
     /**
      * @brief Calculate cosine similarity between two embeddings
      *
+     * For bulk comparisons use a normalised EmbeddingMatrix and
+     * EmbeddingOps::similarity_block instead.
+     *
      * @param emb1 First embedding
      * @param emb2 Second embedding
      * @return Cosine similarity (0.0-1.0, higher = more similar)
@@ -228,6 +423,77 @@ public:
     static float cosine_similarity(const SpeakerEmbedding& emb1,
                                    const SpeakerEmbedding& emb2);
 
+    // ═══════════════════════════════════════════════════════════
+    // Online (Streaming) Diarization
+    // ═══════════════════════════════════════════════════════════
+
+    /**
+     * @brief Feed live audio and get speaker segments as they settle
+     *
+     * Each new embedding window is assigned to the speaker with the highest
+     * average similarity (dot product with the speaker's running embedding
+     * sum / count) if it reaches clustering_threshold; otherwise it opens a
+     * new speaker (up to max_speakers). Every online_recluster_interval
+     * embeddings the speaker centroids are re-clustered with average linkage
+     * on a background thread, and speakers that converged are merged.
+     *
+     * Memory is bounded: only the samples of one partial window and one
+     * [speakers, dim] sum matrix are kept, independent of stream length.
+     * The row of a speaker merged away is given to the next new speaker, so
+     * the matrix never holds more rows than the peak number of live speakers.
+     * Speaker IDs are never reused: each new speaker takes the next ID.
+     * Returned segments are final (later merges do not rewrite them).
+     *
+     * @param audio_data Audio samples (mono, 16kHz), any block size
+     * @param num_samples Number of samples
+     * @return Segments that closed during this call (time relative to stream start)
+     */
+    std::vector<DiarizationSegment> push(const float* audio_data, size_t num_samples);
+
+    /**
+     * @brief End of stream: close and return the segment still in progress
+     */
+    std::vector<DiarizationSegment> flush();
+
+    /**
+     * @brief Drop all streaming state (speakers, buffered audio, timeline)
+     */
+    void reset_stream();
+
+    /**
+     * @brief Speakers seen so far in the stream (no per-window embeddings)
+     */
+    std::vector<Speaker> stream_speakers() const;
+
+    // ═══════════════════════════════════════════════════════════
+    // Speaker Profiles
+    // ═══════════════════════════════════════════════════════════
+
+    /**
+     * @brief Profile store used to name speakers across files
+     *
+     * Loaded from speaker_profiles_path at init (empty otherwise). During
+     * diarize(), windows that match a profile above profile_match_threshold
+     * are assigned to it directly and skip clustering; remaining clusters
+     * are matched by centroid. Matched speakers get the profile name as
+     * their label.
+     */
+    SpeakerProfileStore& profile_store() { return *profiles_; }
+
+    /**
+     * @brief Add (or refine) a named profile from a diarized speaker
+     *
+     * Call profile_store().save(path) afterwards to persist it.
+     *
+     * @param result Diarization result containing the speaker
+     * @param speaker_id Speaker to enroll
+     * @param name Profile name (e.g. "Alice")
+     * @param new_weight Blend weight when the profile already exists (1.0 = replace)
+     * @return Profile index, or -1 if the speaker has no embeddings
+     */
+    int enroll_speaker(const DiarizationResult& result, int speaker_id,
+                       const std::string& name, float new_weight = 0.5f);
+
     // ═══════════════════════════════════════════════════════════
     // Speaker Management
     // ═══════════════════════════════════════════════════════════
@@ -267,22 +533,63 @@ public:
 private:
     DiarizationOptions options_;
 
-    // ONNX Runtime
-    std::unique_ptr<Ort::Env> env_;
-    std::unique_ptr<Ort::Session> embedding_session_;
-    std::unique_ptr<Ort::SessionOptions> session_options_;
-
-    // Model metadata
-    std::vector<int64_t> input_shape_;
-    std::vector<const char*> input_names_;
-    std::vector<const char*> output_names_;
+    // Embedding model (ONNX session pool by default)
+    std::unique_ptr<EmbeddingBackend> backend_;
+
+    // Named speaker profiles (see profile_store())
+    std::unique_ptr<SpeakerProfileStore> profiles_;
+
+    // Online (streaming) state - see push()
+    std::vector<float> stream_buffer_;          // Samples not yet covered by a full window
+    size_t stream_offset_ = 0;                  // Absolute sample index of stream_buffer_[0]
+    float stream_last_end_ = 0.0f;              // End time of the last analysed window
+    std::vector<float> speaker_sums_;           // [slots, dim] sums of assigned unit embeddings
+    std::vector<double> speaker_counts_;        // Embeddings per slot (0 = merged away)
+    std::vector<float> speaker_durations_;      // Speaking time per slot
+    std::vector<int> speaker_ids_;              // Public speaker ID per slot (-1 = merged away)
+    int next_speaker_id_ = 0;                   // Next new speaker's ID (never reused)
+    DiarizationSegment stream_open_;            // Segment still growing (speaker_id -1 = none)
+    float stream_open_confidence_ = 0.0f;       // Sum of window confidences in stream_open_
+    int stream_open_windows_ = 0;
+    size_t embeddings_since_recluster_ = 0;
+    std::vector<size_t> recluster_slots_;       // Slots in the running re-clustering snapshot
+    std::future<std::vector<int>> recluster_future_;  // Background re-clustering (label per snapshot slot)
 
     // Internal methods
-    void initialize_onnx_session();
+    void load_speaker_profiles();
     std::vector<float> run_embedding_model(const float* audio_data, size_t num_samples);
+
+    // Batched inference over windows at the given sample offsets -> normalised matrix
+    EmbeddingMatrix embed_windows(const float* audio_data,
+                                  const std::vector<size_t>& offsets,
+                                  const std::vector<size_t>& lengths,
+                                  std::vector<float> starts,
+                                  std::vector<float> ends);
+
+    // Online mode helpers
+    int assign_stream_embedding(const float* embedding, float& confidence);
+    void close_stream_segment(std::vector<DiarizationSegment>& settled);
+    void start_recluster();
+    void apply_recluster(bool wait);
+
+    // Profile-matched windows labelled directly, the rest clustered; label_names[label]
+    // is the profile name ("" for new speakers)
+    std::vector<int> cluster_with_profiles(const EmbeddingMatrix& embeddings,
+                                           std::vector<std::string>& label_names);
+
+    // Clustering + segment building shared by both diarize() overloads
+    DiarizationResult diarize_embeddings(const EmbeddingMatrix& embeddings);
+
+    // Speakers from per-window cluster labels, ordered by speaking time;
+    // labels are rewritten to the final speaker IDs
+    static std::vector<Speaker> build_speakers(const EmbeddingMatrix& embeddings,
+                                               std::vector<int>& labels);
+
+    // One segment per window, speaker taken from labels[i]; confidence is the
+    // window's similarity to its speaker centroid
     std::vector<DiarizationSegment> embeddings_to_segments(
-        const std::vector<SpeakerEmbedding>& embeddings,
-        const std::vector<Speaker>& speakers);
+        const EmbeddingMatrix& embeddings,
+        const std::vector<int>& labels);
 };
 
 /**
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "export.h"
+#include <cstddef>
+
+namespace muninn {
+
+/**
+ * @brief Dense kernels over row-major embedding matrices
+ *
+ * Speaker embeddings are stored L2-normalised in one contiguous [N, D]
+ * buffer, so cosine similarity reduces to a dot product and all-pairs
+ * similarity is a GEMM (A * B^T). The kernels use AVX2/FMA or NEON when the
+ * library is compiled for them and fall back to scalar code otherwise.
+ */
+namespace EmbeddingOps {
+    /**
+     * @brief Dot product of two D-dimensional vectors
+     */
+    MUNINN_API float dot(const float* a, const float* b, size_t dim);
+
+    /**
+     * @brief L2-normalise one vector in place
+     *
+     * @return Original L2 norm (zero vectors are left unchanged)
+     */
+    MUNINN_API float normalize(float* v, size_t dim);
+
+    /**
+     * @brief L2-normalise every row of a row-major [rows, dim] matrix
+     */
+    MUNINN_API void normalize_rows(float* data, size_t rows, size_t dim);
+
+    /**
+     * @brief Blocked similarity kernel: out[i * ld_out + j] = dot(a_i, b_j)
+     *
+     * Computes A * B^T for row-major A [rows_a, dim] and B [rows_b, dim].
+     * With normalised rows this is the cosine similarity block.
+     *
+     * @param ld_out Row stride of out (>= rows_b)
+     */
+    MUNINN_API void similarity_block(const float* a, size_t rows_a,
+                                     const float* b, size_t rows_b,
+                                     size_t dim, float* out, size_t ld_out);
+
+    /**
+     * @brief All-pairs similarity of one matrix: out [rows, rows] = A * A^T
+     *
+     * Only the upper block triangle is computed; the rest is mirrored.
+     */
+    MUNINN_API void similarity_matrix(const float* data, size_t rows, size_t dim, float* out);
+}
+
+} // namespace muninn
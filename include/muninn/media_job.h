@@ -0,0 +1,106 @@
+#pragma once
+
+#include "export.h"
+#include "transcriber.h"
+#include "translator.h"
+#include "types.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace muninn {
+
+/**
+ * @brief Options for a combined transcribe-and-translate job
+ */
+struct MediaJobOptions {
+    ModelOptions whisper;                    // Whisper model, device and precision
+
+    // Translation (NLLB)
+    std::string translation_model_path;      // NLLB model directory ("" = transcription only)
+    std::string translation_compute_type;    // "" = float16 on CUDA, int8 on CPU
+    std::vector<std::string> target_langs;   // Languages to translate into (first fills translated_text)
+    TranslationOptions translation;          // NLLB decoding options
+
+    // Scheduling - Whisper has priority on the shared device
+    int cpu_threads = 0;                     // CPU budget shared by both models (0 = all cores)
+    float translation_thread_share = 0.25f;  // Part of cpu_threads given to NLLB on CPU
+    int background_max_batch_size = 512;     // NLLB token budget per batch while Whisper is running
+};
+
+/**
+ * @brief Transcribe and translate a media file with one pair of models
+ *
+ * Owns a Transcriber and a Translator placed on the same device (same GPU
+ * index, or a split CPU thread budget). Segments are translated on a
+ * background worker as Whisper finishes each batch of 30s chunks (each track,
+ * with diarization), while decoding continues, so total wall time is close to transcription time alone rather than the sum of both.
+ *
+ * Whisper has priority: while it is running, NLLB works in small batches
+ * (background_max_batch_size tokens) so it never holds the GPU for long, and
+ * on CPU it only gets translation_thread_share of the threads. Once
+ * transcription finishes, the remaining translations run at full batch size.
+ *
+ * Example:
+ * @code
+ *   MediaJobOptions job_options;
+ *   job_options.whisper.model_path = "models/faster-whisper-large-v3-turbo";
+ *   job_options.whisper.device = DeviceType::CUDA;
+ *   job_options.translation_model_path = "models/nllb-200-distilled-600M";
+ *   job_options.target_langs = {"es", "fr"};
+ *
+ *   MediaJob job(job_options);
+ *   auto result = job.run("video.mp4");
+ *   for (const auto& seg : result.segments) {
+ *       std::cout << seg.text << " -> " << seg.translated_text << "\n";
+ *   }
+ * @endcode
+ */
+class MUNINN_API MediaJob {
+public:
+    /**
+     * @brief Load both models
+     *
+     * @throws std::runtime_error if either model cannot be loaded
+     */
+    explicit MediaJob(const MediaJobOptions& options);
+
+    ~MediaJob();
+
+    MediaJob(const MediaJob&) = delete;
+    MediaJob& operator=(const MediaJob&) = delete;
+
+    /**
+     * @brief Transcribe a file and translate every segment into the target languages
+     *
+     * @param media_path Path to audio/video file
+     * @param options Transcription configuration
+     * @param progress_callback Optional callback for transcription progress
+     * @return Transcription result; segments carry translated_text (first target)
+     *         and translations (all targets, when there are several)
+     */
+    TranscribeResult run(const std::string& media_path,
+                         const TranscribeOptions& options = {},
+                         ProgressCallback progress_callback = nullptr);
+
+    /**
+     * @brief Cancel transcription and translation (thread-safe)
+     */
+    void cancel();
+
+    /**
+     * @brief Whisper model owned by the job
+     */
+    Transcriber& transcriber();
+
+    /**
+     * @brief NLLB model owned by the job (nullptr if no translation model was given)
+     */
+    Translator* translator();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace muninn
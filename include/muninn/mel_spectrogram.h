@@ -5,6 +5,8 @@
 
 namespace muninn {
 
+class SpeechView;
+
 /**
  * @brief Whisper-compatible mel-spectrogram converter
  *
@@ -42,6 +44,19 @@ public:
     int compute(const std::vector<float>& samples,
                 std::vector<std::vector<float>>& mel_output);
 
+    /**
+     * @brief Convert a VAD speech view to mel-spectrogram
+     *
+     * Reads frames straight through the view's spans - the speech-only
+     * signal is never materialized.
+     *
+     * @param samples Virtual speech signal
+     * @param mel_output Output mel-spectrogram (n_frames x n_mels)
+     * @return Number of frames generated
+     */
+    int compute(const SpeechView& samples,
+                std::vector<std::vector<float>>& mel_output);
+
     /**
      * @brief Get number of mel bins
      */
@@ -49,7 +64,7 @@ public:
 
 private:
     // Compute Short-Time Fourier Transform
-    void computeSTFT(const std::vector<float>& samples,
+    void computeSTFT(const SpeechView& samples,
                      std::vector<std::vector<std::complex<float>>>& stft_output);
 
     // Create Hann window
@@ -24,6 +24,16 @@ struct SileroVADOptions {
     bool use_gpu = false;                   // Use CUDA (default: false - CPU is faster for VAD)
     int gpu_device_id = 0;                  // CUDA device ID
 
+    // Parallel sharding (long single tracks)
+    // The track is split into num_shards contiguous shards, run in parallel on
+    // at most hardware_concurrency() threads. Each shard (except the first) starts shard_warmup_s earlier with a
+    // fresh LSTM state so it re-converges before its own region; the warm-up
+    // outputs are discarded. Segmentation then runs once over the stitched
+    // probabilities, so results are deterministic for a given shard count.
+    int num_shards = 1;                     // 1 = sequential (exact), >1 = parallel shards
+    float shard_warmup_s = 2.0f;            // Warm-up overlap fed before each shard
+    float min_shard_duration_s = 60.0f;     // Never make shards shorter than this
+
     // Internal parameters (usually don't need to change)
     int window_size_samples = 512;          // 32ms at 16kHz
     int sample_rate = 16000;                // Only 8kHz or 16kHz supported
@@ -78,9 +88,36 @@ public:
         int sample_rate = 16000
     );
 
+    /**
+     * @brief Per-window speech probabilities (window_size_samples each)
+     *
+     * Uses the same sequential or sharded model pass as detect_speech().
+     * Mainly useful for comparing sharded output against a sequential run.
+     *
+     * @param samples Audio samples (mono, float32, 16kHz)
+     * @return One probability per full window
+     */
+    std::vector<float> speech_probabilities(const std::vector<float>& samples);
+
+    /**
+     * @brief Detect speech and return a zero-copy view of the speech portions
+     *
+     * @param samples Input audio samples (must outlive the returned view)
+     * @param sample_rate Sample rate
+     * @param segments Output: detected speech segments
+     * @return View over speech portions (empty if silent track)
+     */
+    SpeechView speech_view(
+        const std::vector<float>& samples,
+        int sample_rate,
+        std::vector<SpeechSegment>& segments
+    );
+
     /**
      * @brief Filter audio to only speech portions
      *
+     * Materializes speech_view() into a new buffer.
+     *
      * @param samples Input audio samples
      * @param sample_rate Sample rate
      * @param segments Output: detected speech segments
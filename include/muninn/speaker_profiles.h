@@ -0,0 +1,109 @@
+#pragma once
+
+#include "muninn/export.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace muninn {
+
+/**
+ * @brief One speaker-profile search hit
+ */
+struct ProfileMatch {
+    int index = -1;                  // Profile index in the store
+    std::string name;                // Profile name ("Alice", "Host", ...)
+    float similarity = 0.0f;         // Cosine similarity to the query
+};
+
+/**
+ * @brief Persistent store of named speaker profiles
+ *
+ * Each profile is one L2-normalised centroid embedding. The store file is a
+ * compact binary layout that is memory-mapped at load, so opening a large
+ * library costs no parsing or copying:
+ *
+ *   [header: "MSPK", version, dim, count]
+ *   [count x 64-byte UTF-8 names, NUL-padded]
+ *   [count x dim float32 embeddings, row-major]
+ *
+ * Matching is a top-k dot-product search (EmbeddingOps::similarity_block).
+ * Adding or updating profiles copies the mapped data into memory; call
+ * save() to write it back.
+ *
+ * Example:
+ * @code
+ *   SpeakerProfileStore store;
+ *   store.load("profiles/hosts.mspk");
+ *   auto hits = store.search(centroid.data(), 1);
+ *   if (!hits.empty() && hits[0].similarity > 0.75f) label = hits[0].name;
+ * @endcode
+ */
+class MUNINN_API SpeakerProfileStore {
+public:
+    static constexpr size_t kNameBytes = 64;    // Fixed name field (incl. NUL)
+
+    SpeakerProfileStore();
+    ~SpeakerProfileStore();
+
+    SpeakerProfileStore(const SpeakerProfileStore&) = delete;
+    SpeakerProfileStore& operator=(const SpeakerProfileStore&) = delete;
+
+    /**
+     * @brief Memory-map a profile file (replaces current contents)
+     * @return True if successful (see get_last_error() otherwise)
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Write all profiles to a file
+     * @return True if successful (see get_last_error() otherwise)
+     */
+    bool save(const std::string& path);
+
+    /**
+     * @brief Add a profile, or update the one with the same name
+     *
+     * The embedding is L2-normalised. Updating blends the stored centroid
+     * with the new one by weight (new_weight in 0.0-1.0).
+     *
+     * @return Profile index
+     */
+    int add_profile(const std::string& name, const float* embedding, size_t dim,
+                    float new_weight = 1.0f);
+
+    /**
+     * @brief Top-k profiles for one (normalised) query embedding
+     */
+    std::vector<ProfileMatch> search(const float* query, size_t k = 1) const;
+
+    /**
+     * @brief Best profile per query row: [num_queries] matches (index -1 if store empty)
+     *
+     * One blocked similarity pass over all queries.
+     */
+    std::vector<ProfileMatch> best_matches(const float* queries, size_t num_queries) const;
+
+    /**
+     * @brief Index of a profile by name (-1 if absent)
+     */
+    int find(const std::string& name) const;
+
+    size_t size() const;
+    size_t dim() const;
+    bool empty() const { return size() == 0; }
+    std::string name(size_t index) const;
+    const float* embedding(size_t index) const;
+
+    /**
+     * @brief Get last error message
+     */
+    std::string get_last_error() const { return last_error_; }
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl_;
+    std::string last_error_;
+};
+
+} // namespace muninn
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "types.h"
+#include <vector>
+#include <cstddef>
+
+namespace muninn {
+
+struct SpeechSegment;
+
+/**
+ * @brief Zero-copy view of the speech portions of an audio buffer
+ *
+ * Presents the VAD speech spans of a track as one virtual contiguous signal,
+ * so mel extraction can read speech-only audio without concatenating it into
+ * a new buffer. A cumulative offset table (filtered position of each span)
+ * maps filtered timestamps back to the original timeline with a binary search.
+ *
+ * The view does NOT own the samples - the source buffer must outlive it.
+ *
+ * Example:
+ * @code
+ *   std::vector<SpeechSegment> segments;
+ *   SpeechView speech = vad.speech_view(samples, 16000, segments);
+ *   mel.compute(speech, mel_features);            // reads through the spans
+ *   float t = speech.to_original_time(12.5f);     // filtered -> original seconds
+ * @endcode
+ */
+class SpeechView {
+public:
+    /**
+     * @brief Empty view (no audio - e.g. silent track)
+     */
+    SpeechView() = default;
+
+    /**
+     * @brief View over the whole buffer as a single span (no VAD)
+     *
+     * @param samples Audio samples (mono, float32)
+     * @param num_samples Number of samples
+     * @param sample_rate Sample rate (typically 16000)
+     */
+    SpeechView(const float* samples, size_t num_samples, int sample_rate = 16000);
+
+    /**
+     * @brief View over the speech segments of a buffer
+     *
+     * Segment times are clamped to the buffer exactly like the old
+     * filter_silence() concatenation, so the virtual signal is sample-identical.
+     *
+     * @param samples Audio samples (mono, float32)
+     * @param num_samples Number of samples
+     * @param segments Speech segments (original timeline, seconds)
+     * @param sample_rate Sample rate (typically 16000)
+     */
+    SpeechView(const float* samples, size_t num_samples,
+               const std::vector<SpeechSegment>& segments,
+               int sample_rate = 16000);
+
+    /**
+     * @brief Number of samples in the virtual (filtered) signal
+     */
+    size_t size() const { return offsets_.empty() ? 0 : offsets_.back(); }
+
+    bool empty() const { return size() == 0; }
+
+    int sample_rate() const { return sample_rate_; }
+
+    /**
+     * @brief Duration of the virtual signal in seconds
+     */
+    float duration() const { return static_cast<float>(size()) / sample_rate_; }
+
+    /**
+     * @brief Number of contiguous spans backing the view
+     */
+    size_t span_count() const { return spans_.size(); }
+
+    /**
+     * @brief Random access into the virtual signal (O(log spans))
+     *
+     * Prefer read() for sequential access.
+     */
+    float operator[](size_t pos) const;
+
+    /**
+     * @brief Copy a range of the virtual signal into a buffer
+     *
+     * @param pos Start position in the virtual signal
+     * @param dst Destination buffer (at least count floats)
+     * @param count Number of samples requested
+     * @return Number of samples copied (less than count at the end of the view)
+     */
+    size_t read(size_t pos, float* dst, size_t count) const;
+
+    /**
+     * @brief Materialize the virtual signal (legacy filter_silence() output)
+     */
+    std::vector<float> to_vector() const;
+
+    /**
+     * @brief Map a timestamp in the virtual signal back to the original timeline
+     *
+     * Timestamps exactly on a span boundary map to the end of the earlier span;
+     * timestamps past the end map to the end of the last span.
+     *
+     * @param filtered_time Time in seconds within the virtual signal
+     * @return Time in seconds within the original buffer
+     */
+    float to_original_time(float filtered_time) const;
+
+    /**
+     * @brief Remap all segment and word timestamps to the original timeline
+     *
+     * Gathers every start/end (segments and words), sorts them once and maps
+     * them in a single merge pass over the offset table - O((T + S) log T)
+     * for T timestamps and S spans instead of a search per timestamp.
+     * Results are identical to calling to_original_time() on each value.
+     *
+     * @param segments Segments with filtered-timeline timestamps (modified in place)
+     */
+    void remap_to_original(std::vector<Segment>& segments) const;
+
+    /**
+     * @brief Fraction of an original-timeline range covered by speech spans
+     *
+     * O(log S) via the cumulative offset table.
+     *
+     * @param start Range start in seconds (original timeline)
+     * @param end Range end in seconds (original timeline)
+     * @return Overlap fraction (0.0-1.0); 1.0 if the view is empty
+     */
+    float speech_overlap(float start, float end) const;
+
+private:
+    struct Span {
+        size_t begin;   // First sample (original buffer)
+        size_t end;     // One past last sample (original buffer)
+    };
+
+    const float* samples_ = nullptr;
+    int sample_rate_ = 16000;
+    std::vector<Span> spans_;
+    std::vector<size_t> offsets_;   // offsets_[i] = virtual position of spans_[i].begin, back() = size()
+
+    // Index of the span containing virtual position pos (pos < size())
+    size_t find_span(size_t pos) const;
+
+    // Speech samples (original timeline) before original sample position pos
+    double speech_before(double pos) const;
+};
+
+} // namespace muninn
@@ -9,6 +9,9 @@
 
 namespace muninn {
 
+struct AudioStatistics;
+struct SpeechSegment;
+
 /**
  * @brief Audio file information (from Heimdall)
  */
@@ -30,6 +33,19 @@ struct MUNINN_API AudioInfo {
  */
 using ProgressCallback = std::function<bool(int track_index, int total_tracks, float progress, const std::string& message)>;
 
+/**
+ * @brief Segment callback for incremental consumers (e.g. TranslationPipeline)
+ *
+ * Called with final segments as soon as they are ready, before transcribe()
+ * returns: once per batch of 30s chunks while a track is still decoding, in
+ * timeline order. With diarization enabled, segments are held back until the
+ * track's speakers are assigned and arrive once per track. Runs on the
+ * transcription thread; hand heavy work to another thread.
+ *
+ * @param segments Finished segments (one batch of chunks, or one diarized track)
+ */
+using SegmentCallback = std::function<void(const std::vector<Segment>& segments)>;
+
 /**
  * @brief High-level Whisper transcription API
  *
@@ -57,6 +73,8 @@ public:
      * @brief Initialize Whisper transcriber with ModelOptions
      *
      * Recommended constructor for full control over model initialization.
+     * Transcribers for the same model path and device share one set of
+     * weights for as long as any of them is alive.
      *
      * @param options Model configuration including device, compute type, threading
      * @throws std::runtime_error if model cannot be loaded
@@ -163,9 +181,19 @@ public:
         int device_index;          // GPU index (0 for CPU)
         std::string gpu_name;      // GPU name (empty for CPU)
         size_t gpu_memory_mb;      // GPU total memory in MB (0 for CPU)
+        double load_time_ms;       // Time spent loading the model (0 if weights were shared)
+        bool shared_weights;       // Weights reused from another instance with the same model
+        double warmup_time_ms;     // Time spent in ModelOptions::warmup (0 if disabled)
     };
     DeviceInfo get_device_info() const;
 
+    /**
+     * @brief Receive finished segments while transcribe() is still running
+     *
+     * @param callback Called per batch of chunks (per track with diarization); nullptr to disable
+     */
+    void set_segment_callback(SegmentCallback callback);
+
     /**
      * @brief Request cancellation of ongoing transcription
      *
@@ -194,6 +222,20 @@ public:
     bool is_cancelled() const;
 
 private:
+    // Single-track pipeline; stats (from decoding) let VAD selection skip a pass over the samples.
+    // speech_out (optional) receives the VAD speech timeline in track time (empty if VAD was off).
+    // segment_sink (optional) receives each batch of 30s chunks' finished segments as it completes.
+    TranscribeResult transcribe_track(
+        const std::vector<float>& audio_samples,
+        const AudioStatistics* stats,
+        const TranscribeOptions& options,
+        int track_id,
+        int total_tracks,
+        ProgressCallback progress_callback,
+        std::vector<SpeechSegment>* speech_out = nullptr,
+        const SegmentCallback& segment_sink = nullptr
+    );
+
     class Impl;  // Forward declaration for pimpl idiom
     std::unique_ptr<Impl> pimpl_;
 };
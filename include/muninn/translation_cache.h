@@ -0,0 +1,134 @@
+#pragma once
+
+#include "export.h"
+#include "translator.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace muninn {
+
+/**
+ * @brief Options for the translation memory cache
+ */
+struct TranslationCacheOptions {
+    size_t max_bytes = 64 * 1024 * 1024;  // Budget for keys + translations; least recently used evicted first
+    std::string persist_path;             // "" = memory only; otherwise loaded on construction, saved on destruction
+};
+
+/**
+ * @brief Cache hit/miss counters
+ */
+struct TranslationCacheStats {
+    uint64_t hits = 0;       // Lookups answered from the cache
+    uint64_t misses = 0;     // Lookups that went to the model
+    uint64_t evictions = 0;  // Entries dropped to stay within max_bytes
+    size_t entries = 0;      // Entries currently cached
+    size_t bytes = 0;        // Bytes currently accounted
+
+    double hit_rate() const {
+        uint64_t total = hits + misses;
+        return total > 0 ? static_cast<double>(hits) / total : 0.0;
+    }
+};
+
+/**
+ * @brief LRU translation memory shared by one or more Translators
+ *
+ * Entries are keyed by (source language, target language, options hash,
+ * normalised text), so "Thank you!" and " thank  you! " hit the same entry
+ * only when they normalise the same (whitespace is collapsed, case is kept).
+ * The options hash covers the model (so Translators on different checkpoints
+ * can share a cache without serving each other's output) and the options
+ * that change the output (beam size, penalties, max length); batching
+ * options do not take part.
+ *
+ * All methods are thread-safe.
+ *
+ * Usage:
+ * @code
+ *   TranslationCacheOptions cache_options;
+ *   cache_options.persist_path = "cache/translations.bin";
+ *   auto cache = std::make_shared<TranslationCache>(cache_options);
+ *
+ *   translator.set_cache(cache);
+ *   translator.translate_batch(texts, "en", "es");   // Repeats skip the model
+ *   std::cout << cache->stats().hit_rate() << "\n";
+ * @endcode
+ */
+class MUNINN_API TranslationCache {
+public:
+    explicit TranslationCache(const TranslationCacheOptions& options = {});
+
+    /**
+     * @brief Saves to persist_path (if set)
+     */
+    ~TranslationCache();
+
+    TranslationCache(const TranslationCache&) = delete;
+    TranslationCache& operator=(const TranslationCache&) = delete;
+
+    /**
+     * @brief Look up a translation (marks the entry as recently used)
+     *
+     * @param normalized_text Text already passed through normalize()
+     * @param translation Receives the cached translation on a hit
+     * @return true on a hit
+     */
+    bool lookup(const std::string& source_lang, const std::string& target_lang,
+                uint64_t options_hash, const std::string& normalized_text,
+                std::string& translation);
+
+    /**
+     * @brief Store a translation, evicting least recently used entries as needed
+     */
+    void insert(const std::string& source_lang, const std::string& target_lang,
+                uint64_t options_hash, const std::string& normalized_text,
+                const std::string& translation);
+
+    /**
+     * @brief Load entries from a cache file (merged, oldest first)
+     * @return true on success; see get_last_error() otherwise
+     */
+    bool load(const std::string& path);
+
+    /**
+     * @brief Write all entries to a cache file (least recently used first)
+     * @return true on success; see get_last_error() otherwise
+     */
+    bool save(const std::string& path);
+
+    /**
+     * @brief Drop all entries (counters are kept)
+     */
+    void clear();
+
+    /**
+     * @brief Current counters and occupancy
+     */
+    TranslationCacheStats stats() const;
+
+    /**
+     * @brief Collapse whitespace runs to one space and trim the ends
+     */
+    static std::string normalize(const std::string& text);
+
+    /**
+     * @brief Hash of the model and the options that affect translation output
+     *
+     * @param options Decoding options
+     * @param model_id Identifies the model (Translator uses its canonical model path)
+     */
+    static uint64_t options_hash(const TranslationOptions& options, const std::string& model_id = "");
+
+    /**
+     * @brief Error from the last failed load() or save()
+     */
+    std::string get_last_error() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace muninn
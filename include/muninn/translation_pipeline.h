@@ -0,0 +1,102 @@
+#pragma once
+
+#include "export.h"
+#include "transcriber.h"
+#include "translator.h"
+#include "types.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace muninn {
+
+/**
+ * @brief Options for background translation of transcript segments
+ */
+struct TranslationPipelineOptions {
+    std::string target_lang;               // Target language code ("es", "fr", etc.)
+    std::vector<std::string> target_langs; // Several targets in one pass (overrides target_lang; first fills translated_text)
+    std::string source_lang;               // Source language ("" = each segment's detected language)
+    TranslationOptions translation;        // Passed to Translator::translate_batch
+    size_t max_in_flight = 256;            // Segments queued or translating; submit() blocks beyond this
+    size_t max_batch_segments = 64;        // Segments taken per translate_batch call
+    int background_max_batch_size = 512;   // Token budget per model batch while set_background(true)
+};
+
+/**
+ * @brief Translates transcript segments while transcription continues
+ *
+ * Segments are submitted as they are produced (typically through
+ * Transcriber::set_segment_callback) and translated on a background worker,
+ * so Whisper and NLLB run at the same time - on two GPUs, or GPU + CPU.
+ * At most max_in_flight segments wait or translate at once; beyond that
+ * submit() blocks, which throttles the producer instead of growing the queue.
+ *
+ * The pipeline is the only user of the Translator while it runs.
+ *
+ * Example:
+ * @code
+ *   Translator translator("models/nllb-200-distilled-600M", "cpu", "int8");
+ *   TranslationPipelineOptions pipeline_options;
+ *   pipeline_options.target_lang = "es";
+ *   TranslationPipeline pipeline(translator, pipeline_options);
+ *
+ *   transcriber.set_segment_callback(pipeline.segment_callback());
+ *   auto result = transcriber.transcribe("video.mp4", options);
+ *   pipeline.finish(result);   // segments now carry translated_text
+ * @endcode
+ */
+class MUNINN_API TranslationPipeline {
+public:
+    TranslationPipeline(Translator& translator, const TranslationPipelineOptions& options);
+
+    /**
+     * @brief Stops the worker (segments not yet translated are discarded)
+     */
+    ~TranslationPipeline();
+
+    TranslationPipeline(const TranslationPipeline&) = delete;
+    TranslationPipeline& operator=(const TranslationPipeline&) = delete;
+
+    /**
+     * @brief Queue segments for translation (blocks while max_in_flight are pending)
+     */
+    void submit(const std::vector<Segment>& segments);
+
+    /**
+     * @brief Yield to a model sharing the device
+     *
+     * While enabled, model batches are capped at background_max_batch_size
+     * tokens so each NLLB job is short and work from the other model (e.g.
+     * Whisper on the same GPU) is not held behind a long translation batch.
+     */
+    void set_background(bool background);
+
+    /**
+     * @brief Callback that submits each batch of segments (for Transcriber::set_segment_callback)
+     */
+    SegmentCallback segment_callback();
+
+    /**
+     * @brief Wait for all submitted segments and return them translated
+     *
+     * @return Segments in submission order with translated_text/translation_target
+     *         (and translations, for several targets) set
+     */
+    std::vector<Segment> finish();
+
+    /**
+     * @brief Wait for all submitted segments and attach translations to a result
+     *
+     * Segments are matched by track, start and end time.
+     *
+     * @param result Transcription result whose segments were submitted
+     */
+    void finish(TranscribeResult& result);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace muninn
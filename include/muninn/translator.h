@@ -1,12 +1,15 @@
 #pragma once
 
 #include "export.h"
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
 
 namespace muninn {
 
+class TranslationCache;
+
 /**
  * @brief Language information for translation
  */
@@ -25,8 +28,25 @@ struct TranslationOptions {
     int max_length = 256;           // Maximum output tokens per segment
     float repetition_penalty = 1.0f; // Repetition penalty
     int no_repeat_ngram_size = 0;   // Prevent n-gram repetitions (0 = disabled)
+
+    // Batching (translate_batch)
+    int max_batch_size = 2048;      // Budget per model batch in batch_type units (0 = one batch)
+    std::string batch_type = "tokens"; // "tokens" (padded tokens: longest x count) or "examples"
+    bool sort_by_length = true;     // Batch similar-length texts together (output order is kept)
+
+    // Tokenization
+    int tokenizer_threads = 0;      // Workers for SentencePiece encode/decode (0 = auto, 1 = calling thread)
 };
 
+/**
+ * @brief Receives a partial translation while it is being decoded
+ *
+ * @param text Translation so far (whole words only until is_final)
+ * @param is_final true on the last call, with the finished translation
+ * @return false to stop decoding; the text so far becomes the result
+ */
+using TranslationStreamCallback = std::function<bool(const std::string& text, bool is_final)>;
+
 /**
  * @brief Text translator using NLLB-200 model via CTranslate2
  *
@@ -44,6 +64,11 @@ struct TranslationOptions {
  * Performance Tips:
  * - Use translate_batch() instead of calling translate() in a loop (5-10x faster)
  * - Batch translation amortizes tokenization and GPU kernel launch overhead
+ * - translate_batch() sorts texts by token length and fills each model batch
+ *   up to TranslationOptions::max_batch_size padded tokens, so short and long
+ *   segments are not padded to each other; raise the budget on large GPUs
+ * - Repeated texts within a batch are translated once; attach a
+ *   TranslationCache (set_cache) to also skip texts seen in earlier calls
  *
  * Usage:
  * @code
@@ -64,13 +89,18 @@ public:
      * @param device "cuda" or "cpu" (default: "cuda")
      * @param compute_type "float16", "int8", "float32" (default: "float16")
      * @param device_index GPU index for multi-GPU systems (default: 0)
+     * @param intra_threads CPU threads for the model (0 = CTranslate2 default)
+     *
+     * Translators with the same model, device, compute type and threads
+     * share one set of weights for as long as any of them is alive.
      *
      * @throws std::runtime_error if model cannot be loaded
      */
     Translator(const std::string& model_path,
                const std::string& device = "cuda",
                const std::string& compute_type = "float16",
-               int device_index = 0);
+               int device_index = 0,
+               int intra_threads = 0);
 
     ~Translator();
 
@@ -94,6 +124,30 @@ public:
                           const std::string& target_lang,
                           const TranslationOptions& options = {});
 
+    /**
+     * @brief Translate a single text, reporting words as they are decoded
+     *
+     * For live captions: the callback receives the growing translation
+     * after each completed word, so the first words show long before the
+     * whole sentence is decoded. Decoding uses greedy search (beam_size is
+     * ignored) and stops early when the callback returns false or cancel()
+     * is called - e.g. once the source segment has been superseded.
+     *
+     * The callback runs on a CTranslate2 worker thread; keep it short.
+     *
+     * @param text Source text to translate
+     * @param source_lang Source language code
+     * @param target_lang Target language code
+     * @param callback Receives partial and final translations
+     * @param options Translation options
+     * @return Final translation (partial if stopped early, original text on failure)
+     */
+    std::string translate_streaming(const std::string& text,
+                                    const std::string& source_lang,
+                                    const std::string& target_lang,
+                                    const TranslationStreamCallback& callback,
+                                    const TranslationOptions& options = {});
+
     /**
      * @brief Translate multiple texts in a batch (more efficient)
      *
@@ -124,6 +178,40 @@ public:
         const std::vector<std::string>& target_langs,
         const TranslationOptions& options = {});
 
+    /**
+     * @brief Translate many texts to several target languages in one pass
+     *
+     * Each text is tokenized once; every (text x target) pair then goes
+     * through the same length-bucketed batches as translate_batch(), with a
+     * per-pair target language prefix. Much faster than one translate_batch()
+     * call per language for subtitle jobs with many targets.
+     *
+     * @param texts Source texts
+     * @param source_lang Source language code
+     * @param target_langs Target language codes
+     * @param options Translation options
+     * @return (target_lang, translations in input order) per target, in target_langs order
+     */
+    std::vector<std::pair<std::string, std::vector<std::string>>> translate_batch_multi_target(
+        const std::vector<std::string>& texts,
+        const std::string& source_lang,
+        const std::vector<std::string>& target_langs,
+        const TranslationOptions& options = {});
+
+    /**
+     * @brief Attach a translation memory (nullptr to detach)
+     *
+     * translate_batch() and the multi-target methods answer cached texts
+     * without the model and store new translations. The cache may be shared
+     * between Translators.
+     */
+    void set_cache(std::shared_ptr<TranslationCache> cache);
+
+    /**
+     * @brief Attached translation memory (nullptr if none)
+     */
+    std::shared_ptr<TranslationCache> cache() const;
+
     /**
      * @brief Check if a language is supported
      * @param lang_code Language code ("en", "ja", etc.)
@@ -4,20 +4,21 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <utility>
 
 namespace muninn {
 
 /**
  * @brief VAD algorithm type (user-selectable in GUI)
  *
- * API Options: Auto (default), None, Energy, Silero
+ * API Options: Auto (default), None, Energy, Silero, WebRTC
  */
 enum class VADType {
     Auto,           // Auto-detect best VAD per track (DEFAULT - recommended for multi-track)
     None,           // No VAD - process all audio (use for clean audio or when VAD causes issues)
     Energy,         // Energy-based VAD (fast, no dependencies, works with music/mixed audio)
     Silero,         // Silero VAD ONNX (neural precision for clean speech, requires ONNX Runtime)
-    WebRTC          // WebRTC/Google VAD (future support)
+    WebRTC          // WebRTC-style GMM VAD (native, robust on music beds, cheap on CPU)
 };
 
 /**
@@ -64,8 +65,11 @@ struct Word {
     float intensity;         // Audio intensity/volume (0.0-1.0, normalized RMS)
     EmphasisLevel emphasis;  // Emphasis level (derived from intensity)
 
+    // Speaker diarization (multi-speaker mode)
+    int speaker_id;          // Speaker of this word (-1 if not assigned)
+
     Word() : start(0.0f), end(0.0f), probability(1.0f),
-             intensity(0.5f), emphasis(EmphasisLevel::Normal) {}
+             intensity(0.5f), emphasis(EmphasisLevel::Normal), speaker_id(-1) {}
 };
 
 /**
@@ -97,6 +101,7 @@ struct Segment {
     // Translation (when post-transcription translation is enabled)
     std::string translated_text;    // Translated text (empty if no translation)
     std::string translation_target; // Target language code ("es", "fr", etc.)
+    std::vector<std::pair<std::string, std::string>> translations;  // (target, text) per target in multi-target jobs
 
     Segment() : id(0), track_id(0), start(0.0f), end(0.0f),
                 language_probability(0.0f),
@@ -160,6 +165,11 @@ struct TranscribeOptions {
 
     // Silero VAD specific
     std::string silero_model_path;         // Path to silero_vad.onnx (required for VADType::Silero)
+    int silero_num_shards = 1;             // Parallel VAD shards for long tracks (1 = sequential)
+
+    // WebRTC VAD specific
+    int webrtc_aggressiveness = 2;         // 0 (keeps most audio) - 3 (most aggressive)
+    int webrtc_frame_duration_ms = 30;     // Analysis frame: 10, 20 or 30 ms
 
     // ═══════════════════════════════════════════════════════════
     // Hallucination Filtering
@@ -186,7 +196,8 @@ struct TranscribeOptions {
     // Multi-Track Processing
     // ═══════════════════════════════════════════════════════════
     std::set<int> skip_tracks;             // Track indices to skip (empty = process all)
-    bool skip_silent_tracks = true;        // Auto-skip tracks with no audio signal
+    bool skip_silent_tracks = true;        // Auto-skip tracks with no audio signal (decided from decode stats)
+    bool skip_music_tracks = false;        // Auto-skip continuous music-only tracks (heuristic, no pauses)
 
     // ═══════════════════════════════════════════════════════════
     // Speaker Diarization ("Who Said What")
@@ -196,6 +207,9 @@ struct TranscribeOptions {
     float diarization_threshold = 0.7f;    // Speaker clustering threshold (0.5-0.9)
     int diarization_min_speakers = 1;      // Minimum number of speakers
     int diarization_max_speakers = 10;     // Maximum number of speakers (0 = unlimited)
+    std::string diarization_profiles_path; // Optional: speaker profile store (.mspk) for named speakers
+    int diarization_parallel_tracks = 2;   // Tracks diarized concurrently (overlaps Whisper on later tracks)
+    bool diarization_split_segments = true; // Split segments at speaker changes (needs word_timestamps)
 
     // ═══════════════════════════════════════════════════════════
     // Performance Tuning
@@ -231,6 +245,12 @@ struct ModelOptions {
     // GPU options
     int device_index = 0;                  // GPU index for multi-GPU systems
 
+    // Warm-up: pay allocator growth, kernel selection and CUDA context setup
+    // in the constructor instead of in the first transcribe()
+    bool warmup = false;                   // Run synthetic windows through generate/detect_language/align
+    int warmup_batch_size = 4;             // Match TranscribeOptions::batch_size
+    int warmup_beam_size = 5;              // Match TranscribeOptions::beam_size
+
     // Helper to convert enums to strings for CTranslate2
     std::string device_string() const {
         switch (device) {
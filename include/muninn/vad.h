@@ -1,6 +1,8 @@
 #pragma once
 
 #include "types.h"
+#include "speech_view.h"
+#include "audio_stats.h"
 #include <vector>
 #include <cstdint>
 
@@ -53,9 +55,29 @@ public:
         int sample_rate = 16000
     );
 
+    /**
+     * @brief Detect speech and return a zero-copy view of the speech portions
+     *
+     * Preferred over filter_silence(): no filtered buffer is allocated, and the
+     * view maps filtered timestamps back to the original timeline.
+     *
+     * @param samples Input audio samples (must outlive the returned view)
+     * @param sample_rate Sample rate
+     * @param segments Output: detected speech segments
+     * @return View over speech portions (empty if the track is silent,
+     *         whole buffer if no speech was detected)
+     */
+    SpeechView speech_view(
+        const std::vector<float>& samples,
+        int sample_rate,
+        std::vector<SpeechSegment>& segments
+    );
+
     /**
      * @brief Filter audio to only speech portions
      *
+     * Materializes speech_view() into a new buffer.
+     *
      * @param samples Input audio samples
      * @param sample_rate Sample rate
      * @param segments Output: detected speech segments
@@ -69,7 +91,7 @@ public:
 
     /**
      * @brief Get duration of silence removed
-     * @return Seconds of silence removed in last filter_silence() call
+     * @return Seconds of silence removed in last speech_view()/filter_silence() call
      */
     float get_silence_removed() const { return silence_removed_; }
 
@@ -99,6 +121,8 @@ struct AudioCharacteristics {
     float dynamic_range;    // Difference between speech and noise
     float max_amplitude;    // Maximum amplitude
     bool is_silent;         // True if max amplitude is near zero
+    float level_spread_db;  // 90th - 10th percentile of 32ms frame level (dB)
+    bool is_music_like;     // Loud, continuous programme audio with no pauses (music beds)
 };
 
 /**
@@ -109,6 +133,17 @@ struct AudioCharacteristics {
  */
 AudioCharacteristics analyze_audio_characteristics(const std::vector<float>& samples);
 
+/**
+ * @brief Analyze audio characteristics from precomputed statistics
+ *
+ * No pass over the samples - use with statistics gathered during decoding
+ * (AudioExtractor::extract_track).
+ *
+ * @param stats Track statistics
+ * @return Audio characteristics
+ */
+AudioCharacteristics analyze_audio_characteristics(const AudioStatistics& stats);
+
 /**
  * @brief Auto-detect best VAD type for audio
  *
@@ -116,12 +151,13 @@ AudioCharacteristics analyze_audio_characteristics(const std::vector<float>& sam
  * 1. Multi-track Track 0 → Energy VAD (desktop/game audio with music)
  * 2. Very clean speech (noise floor < 0.0001) → Silero VAD (noise gates, studio mics)
  * 3. Clean speech (noise floor < 0.01, dynamic range > 0.15) → Silero VAD
- * 4. Mixed/noisy content → Energy VAD (robust fallback)
+ * 4. Continuous music-bed audio (no pauses) → WebRTC VAD
+ * 5. Mixed/noisy content → Energy VAD (robust fallback)
  *
  * @param samples Audio samples to analyze
  * @param track_id Track index (0 = first track)
  * @param total_tracks Total number of tracks in file
- * @return Recommended VAD type (Energy or Silero, never Auto/None)
+ * @return Recommended VAD type (never Auto/None)
  */
 VADType auto_detect_vad_type(
     const std::vector<float>& samples,
@@ -129,4 +165,20 @@ VADType auto_detect_vad_type(
     int total_tracks
 );
 
+/**
+ * @brief Auto-detect best VAD type from precomputed statistics
+ *
+ * Same heuristics as above without touching the samples.
+ *
+ * @param stats Track statistics (e.g. from AudioExtractor::extract_track)
+ * @param track_id Track index (0 = first track)
+ * @param total_tracks Total number of tracks in file
+ * @return Recommended VAD type (never Auto/None)
+ */
+VADType auto_detect_vad_type(
+    const AudioStatistics& stats,
+    int track_id,
+    int total_tracks
+);
+
 } // namespace muninn
@@ -287,6 +287,7 @@ int AudioDecoder::extract_streams(
 
     // Validate stream indices and build lookup map
     std::map<int, int> file_index_to_logical;
+    stream_stats_.clear();
     for (int logical_idx : indices_to_use) {
         if (logical_idx < 0 || logical_idx >= static_cast<int>(audio_streams_.size())) {
             continue;
@@ -294,6 +295,7 @@ int AudioDecoder::extract_streams(
         int file_idx = audio_streams_[logical_idx].stream_index;
         file_index_to_logical[file_idx] = logical_idx;
         outputs[logical_idx] = std::vector<float>();
+        stream_stats_[logical_idx].reset();
     }
 
     if (file_index_to_logical.empty()) {
@@ -350,6 +352,7 @@ int AudioDecoder::extract_streams(
                     if (converted > 0) {
                         float* samples = reinterpret_cast<float*>(out_buffer);
                         outputs[logical_idx].insert(outputs[logical_idx].end(), samples, samples + converted);
+                        stream_stats_[logical_idx].add(samples, converted);
                         samples_per_stream[logical_idx] += converted;
                     }
 
@@ -377,6 +380,7 @@ int AudioDecoder::extract_streams(
                 if (converted > 0) {
                     float* samples = reinterpret_cast<float*>(out_buffer);
                     outputs[logical_idx].insert(outputs[logical_idx].end(), samples, samples + converted);
+                    stream_stats_[logical_idx].add(samples, converted);
                     samples_per_stream[logical_idx] += converted;
                 }
                 av_freep(&out_buffer);
@@ -384,6 +388,10 @@ int AudioDecoder::extract_streams(
         }
     }
 
+    for (auto& pair : stream_stats_) {
+        pair.second.finish();
+    }
+
     oss.str("");
     oss << "[Muninn Audio] Extraction complete: " << packets_read << " packets processed";
     TS_PRINT(oss.str());
@@ -403,6 +411,11 @@ int AudioDecoder::extract_streams(
     return successful_streams;
 }
 
+const AudioStatistics* AudioDecoder::get_stream_statistics(int stream_index) const {
+    auto it = stream_stats_.find(stream_index);
+    return it != stream_stats_.end() ? &it->second : nullptr;
+}
+
 std::vector<int> AudioDecoder::get_all_stream_indices() const {
     std::vector<int> indices;
     for (size_t i = 0; i < audio_streams_.size(); i++) {
@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <map>
+#include "muninn/audio_stats.h"
 
 extern "C" {
     #include <libavformat/avformat.h>
@@ -86,6 +87,17 @@ public:
         int quality = 100
     );
 
+    /**
+     * Get statistics accumulated for a stream during the last extract_streams()
+     *
+     * Peak, RMS and level/amplitude histograms are gathered while samples are
+     * resampled, so callers can make track-level decisions without rescanning.
+     *
+     * @param stream_index Logical stream index
+     * @return Statistics, or nullptr if the stream was not extracted
+     */
+    const AudioStatistics* get_stream_statistics(int stream_index) const;
+
     /**
      * Get all stream indices
      */
@@ -111,6 +123,7 @@ private:
     AVFrame* frame_;
     bool is_open_;
     int target_sample_rate_;  // Target sample rate for resampling
+    std::map<int, AudioStatistics> stream_stats_;  // Per logical stream, from last extract_streams()
 
     bool init_stream(int stream_index);
 };
@@ -81,6 +81,12 @@ float AudioExtractor::get_duration() const
 }
 
 bool AudioExtractor::extract_track(int track_index, std::vector<float>& samples)
+{
+    AudioStatistics stats;
+    return extract_track(track_index, samples, stats);
+}
+
+bool AudioExtractor::extract_track(int track_index, std::vector<float>& samples, AudioStatistics& stats)
 {
     last_error_.clear();
 
@@ -114,6 +120,14 @@ bool AudioExtractor::extract_track(int track_index, std::vector<float>& samples)
 
         samples = std::move(tracks[track_index]);
 
+        if (const AudioStatistics* decoded_stats = pimpl_->decoder.get_stream_statistics(track_index)) {
+            stats = *decoded_stats;
+        } else {
+            stats.reset();
+            stats.add(samples.data(), samples.size());
+            stats.finish();
+        }
+
         std::cout << "[Muninn] Track " << track_index << ": extracted " << samples.size()
                   << " samples (" << (samples.size() / static_cast<float>(Impl::WHISPER_SAMPLE_RATE)) << "s at 16kHz)\n";
 
@@ -0,0 +1,124 @@
+#include "muninn/audio_stats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace muninn {
+
+namespace {
+
+// Log2 amplitude bin straight from the float bits: exponent selects the
+// octave, the top 3 mantissa bits select 1/8 octave within it.
+inline int amplitude_bin(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bits &= 0x7FFFFFFFu;  // |x|
+
+    int exponent = static_cast<int>(bits >> 23) - 127;  // floor(log2|x|)
+    if (exponent < -AudioStatistics::kOctaves) {
+        return 0;  // Below 2^-24 (includes zero and denormals)
+    }
+    if (exponent >= 0) {
+        return AudioStatistics::kAmplitudeBins - 1;  // Clipped / >= full scale
+    }
+
+    int sub = static_cast<int>((bits >> 20) & 0x7u);
+    return (exponent + AudioStatistics::kOctaves) * AudioStatistics::kBinsPerOctave + sub;
+}
+
+// Representative |x| for a bin (geometric centre)
+inline float amplitude_bin_value(int bin) {
+    if (bin >= AudioStatistics::kAmplitudeBins - 1) {
+        return 1.0f;
+    }
+    float octave = static_cast<float>(bin) / AudioStatistics::kBinsPerOctave - AudioStatistics::kOctaves;
+    return std::exp2(octave + 0.5f / AudioStatistics::kBinsPerOctave);
+}
+
+// Index of the first bin where the cumulative count reaches p * total
+template <typename Hist>
+int percentile_bin(const Hist& histogram, uint64_t total, float p) {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(std::clamp(p, 0.0f, 1.0f) * static_cast<double>(total));
+    target = std::min(target, total - 1);
+
+    uint64_t cumulative = 0;
+    for (size_t bin = 0; bin < histogram.size(); ++bin) {
+        cumulative += histogram[bin];
+        if (cumulative > target) {
+            return static_cast<int>(bin);
+        }
+    }
+    return static_cast<int>(histogram.size()) - 1;
+}
+
+} // anonymous namespace
+
+void AudioStatistics::add_frame_level(double sum_sq, int count) {
+    double mean_square = sum_sq / count;
+    double db = mean_square > 1e-12 ? 10.0 * std::log10(mean_square) : -120.0;
+    int bin = static_cast<int>(std::lround(db)) + (kLevelBins - 1);
+    level_histogram[std::clamp(bin, 0, kLevelBins - 1)]++;
+    frame_count++;
+}
+
+void AudioStatistics::add(const float* samples, size_t count) {
+    float block_peak = peak;
+    double block_sum = 0.0;
+
+    for (size_t i = 0; i < count; ++i) {
+        float x = samples[i];
+        float sq = x * x;
+
+        block_peak = std::max(block_peak, std::abs(x));
+        block_sum += sq;
+        amplitude_histogram[amplitude_bin(x)]++;
+
+        frame_sum_squares_ += sq;
+        if (++frame_fill_ == kFrameSamples) {
+            add_frame_level(frame_sum_squares_, frame_fill_);
+            frame_sum_squares_ = 0.0;
+            frame_fill_ = 0;
+        }
+    }
+
+    peak = block_peak;
+    sum_squares += block_sum;
+    sample_count += count;
+}
+
+void AudioStatistics::finish() {
+    // Only count a trailing partial frame if it holds at least half a frame
+    if (frame_fill_ >= kFrameSamples / 2) {
+        add_frame_level(frame_sum_squares_, frame_fill_);
+    }
+    frame_sum_squares_ = 0.0;
+    frame_fill_ = 0;
+}
+
+float AudioStatistics::rms() const {
+    if (sample_count == 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(std::sqrt(sum_squares / static_cast<double>(sample_count)));
+}
+
+float AudioStatistics::amplitude_percentile(float p) const {
+    if (sample_count == 0) {
+        return 0.0f;
+    }
+    int bin = percentile_bin(amplitude_histogram, sample_count, p);
+    return bin == 0 ? 0.0f : std::min(amplitude_bin_value(bin), peak);
+}
+
+float AudioStatistics::level_percentile_db(float p) const {
+    if (frame_count == 0) {
+        return -120.0f;
+    }
+    int bin = percentile_bin(level_histogram, frame_count, p);
+    return static_cast<float>(bin - (kLevelBins - 1));
+}
+
+} // namespace muninn
@@ -0,0 +1,267 @@
+#include "model_registry.h"
+#include <ctranslate2/models/model_reader.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace muninn {
+namespace ct2 {
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════
+// Memory-mapped model files
+// ═══════════════════════════════════════════════════════════
+
+// Read-only mapping of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_, &file_size) || file_size.QuadPart == 0) {
+            return;
+        }
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_ == nullptr) {
+            return;
+        }
+        data_ = static_cast<char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_ != nullptr) {
+            size_ = static_cast<size_t>(file_size.QuadPart);
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base != MAP_FAILED) {
+                data_ = static_cast<char*>(base);
+                size_ = static_cast<size_t>(st.st_size);
+                madvise(base, size_, MADV_SEQUENTIAL);  // Read once, front to back
+            }
+        }
+        ::close(fd);  // The mapping keeps the file referenced
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+        if (data_) munmap(data_, size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool ok() const { return data_ != nullptr; }
+    char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+// istream over a mapping: reads are memcpy from the page cache, no read() calls
+class MappedStream : public std::istream {
+public:
+    explicit MappedStream(const std::string& path)
+        : std::istream(nullptr), file_(path), buffer_(file_)
+    {
+        rdbuf(&buffer_);
+    }
+
+    bool ok() const { return file_.ok(); }
+
+private:
+    class Buffer : public std::streambuf {
+    public:
+        explicit Buffer(const MappedFile& file) {
+            // The get area is only read from; streambuf just lacks a const variant
+            setg(file.data(), file.data(), file.data() + file.size());
+        }
+
+    protected:
+        pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode) override {
+            char* target = dir == std::ios_base::beg ? eback() + offset
+                         : dir == std::ios_base::cur ? gptr() + offset
+                                                     : egptr() + offset;
+            if (target < eback() || target > egptr()) {
+                return pos_type(off_type(-1));
+            }
+            setg(eback(), target, egptr());
+            return pos_type(target - eback());
+        }
+
+        pos_type seekpos(pos_type position, std::ios_base::openmode mode) override {
+            return seekoff(off_type(position), std::ios_base::beg, mode);
+        }
+    };
+
+    MappedFile file_;
+    Buffer buffer_;
+};
+
+// Serves model.bin from a mapping, other files (config, vocabulary) as usual
+class MappedModelReader : public ctranslate2::models::ModelReader {
+public:
+    explicit MappedModelReader(std::string model_dir) : model_dir_(std::move(model_dir)) {}
+
+    std::string get_model_id() const override {
+        return model_dir_;
+    }
+
+    std::unique_ptr<std::istream> get_file(const std::string& filename, const bool binary) override {
+        std::filesystem::path path = std::filesystem::path(model_dir_) / filename;
+        if (!std::filesystem::exists(path)) {
+            return nullptr;
+        }
+
+        if (binary) {
+            auto mapped = std::make_unique<MappedStream>(path.string());
+            if (mapped->ok()) {
+                return mapped;
+            }
+        }
+
+        auto mode = binary ? std::ios::in | std::ios::binary : std::ios::in;
+        auto stream = std::make_unique<std::ifstream>(path.string(), mode);
+        if (!*stream) {
+            return nullptr;
+        }
+        return stream;
+    }
+
+private:
+    std::string model_dir_;
+};
+
+// ═══════════════════════════════════════════════════════════
+// Registry
+// ═══════════════════════════════════════════════════════════
+
+// One slot per key; its mutex serialises loading of that key only
+struct Slot {
+    std::mutex mutex;
+    std::weak_ptr<void> model;
+};
+
+std::mutex registry_mutex;
+std::map<std::string, std::shared_ptr<Slot>>& registry() {
+    static std::map<std::string, std::shared_ptr<Slot>> slots;
+    return slots;
+}
+
+std::string canonical_path(const std::string& path) {
+    std::error_code ec;
+    auto canonical = std::filesystem::weakly_canonical(path, ec);
+    return ec ? path : canonical.string();
+}
+
+template <typename Model>
+std::shared_ptr<Model> acquire(const char* kind, const ModelKey& key, LoadInfo* info) {
+    const std::string path = canonical_path(key.path);
+    const bool cuda = key.device == ctranslate2::Device::CUDA;
+    const std::string id = std::string(kind) + "|" + path + "|" + (cuda ? "cuda:" : "cpu:") +
+                           std::to_string(key.device_index) + "|" + key.compute_type + "|" +
+                           std::to_string(key.intra_threads);
+
+    std::shared_ptr<Slot> slot;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        auto& slots = registry();
+        auto it = slots.find(id);
+        if (it == slots.end()) {
+            // Drop slots whose weights were released and that no load is using,
+            // so the map only holds keys that are live (or loading)
+            for (auto s = slots.begin(); s != slots.end();) {
+                if (s->second.use_count() == 1 && s->second->model.expired()) {
+                    s = slots.erase(s);
+                } else {
+                    ++s;
+                }
+            }
+            it = slots.emplace(id, std::make_shared<Slot>()).first;
+        }
+        slot = it->second;
+    }
+
+    std::lock_guard<std::mutex> lock(slot->mutex);
+    if (auto existing = std::static_pointer_cast<Model>(slot->model.lock())) {
+        if (info) {
+            info->load_time_ms = 0.0;
+            info->shared = true;
+        }
+        std::cout << "[Muninn] Sharing loaded " << kind << " model: " << path << "\n";
+        return existing;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    ctranslate2::models::ModelLoader loader(std::make_shared<MappedModelReader>(path));
+    loader.device = key.device;
+    loader.device_indices = {key.device_index};
+    loader.compute_type = ctranslate2::str_to_compute_type(key.compute_type);
+
+    ctranslate2::ReplicaPoolConfig pool_config;
+    pool_config.num_threads_per_replica = key.intra_threads;
+
+    auto model = std::make_shared<Model>(loader, pool_config);
+    slot->model = model;
+
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (info) {
+        info->load_time_ms = elapsed_ms;
+        info->shared = false;
+    }
+    std::cout << "[Muninn] Loaded " << kind << " model in " << static_cast<int>(elapsed_ms) << " ms: " << path << "\n";
+    return model;
+}
+
+} // anonymous namespace
+
+std::shared_ptr<ctranslate2::models::Whisper> acquire_whisper(const ModelKey& key, LoadInfo* info) {
+    return acquire<ctranslate2::models::Whisper>("Whisper", key, info);
+}
+
+std::shared_ptr<ctranslate2::Translator> acquire_translator(const ModelKey& key, LoadInfo* info) {
+    return acquire<ctranslate2::Translator>("translation", key, info);
+}
+
+} // namespace ct2
+} // namespace muninn
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <ctranslate2/models/whisper.h>
+#include <ctranslate2/translator.h>
+#include <memory>
+#include <string>
+
+namespace muninn {
+namespace ct2 {
+
+/**
+ * Identity of a loaded model; requests with equal keys share one set of weights
+ */
+struct ModelKey {
+    std::string path;                                // Model directory (canonicalised by the registry)
+    ctranslate2::Device device = ctranslate2::Device::CPU;
+    int device_index = 0;                            // GPU index
+    std::string compute_type = "default";            // Passed to CTranslate2 ("default" = as saved)
+    size_t intra_threads = 0;                        // CPU threads per replica (0 = CTranslate2 default)
+};
+
+/**
+ * How a handle was obtained
+ */
+struct LoadInfo {
+    double load_time_ms = 0.0;  // Wall time spent loading (0 when shared)
+    bool shared = false;        // Weights were already held by another instance
+};
+
+/**
+ * Process-wide CTranslate2 model registry
+ *
+ * Hands out reference-counted handles: while any Transcriber or Translator
+ * holds a model, further requests with the same key get the same instance
+ * (CTranslate2 replica pools queue concurrent requests internally). The
+ * weights are released with the last handle.
+ *
+ * model.bin is read through a memory mapping instead of buffered file I/O.
+ * Concurrent requests for one key wait for a single load; different keys
+ * load in parallel. Safe to call from any thread.
+ */
+std::shared_ptr<ctranslate2::models::Whisper> acquire_whisper(const ModelKey& key, LoadInfo* info = nullptr);
+std::shared_ptr<ctranslate2::Translator> acquire_translator(const ModelKey& key, LoadInfo* info = nullptr);
+
+} // namespace ct2
+} // namespace muninn
@@ -1,13 +1,229 @@
 #include "muninn/diarization.h"
+#include "onnx/ort_env.h"
 #include <algorithm>
+#include <chrono>
+#include <cctype>
 #include <cmath>
 #include <numeric>
 #include <stdexcept>
 #include <sstream>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <mutex>
+#include <condition_variable>
 
 namespace muninn {
 
+// ═══════════════════════════════════════════════════════════
+// ONNX Embedding Backend
+// ═══════════════════════════════════════════════════════════
+
+#ifdef MUNINN_USE_SILERO_VAD
+
+namespace {
+
+/**
+ * @brief pyannote embedding model on a pool of ONNX Runtime sessions
+ *
+ * Sessions share the process-wide Ort::Env. Each embed() call leases one
+ * session (and its input buffer), so concurrent diarize() calls run on
+ * separate sessions with the intra-op threads split between them.
+ */
+class OnnxEmbeddingBackend : public EmbeddingBackend {
+public:
+    explicit OnnxEmbeddingBackend(const DiarizationOptions& options) {
+        try {
+            const size_t num_sessions = static_cast<size_t>(std::max(1, options.num_sessions));
+            const int threads_per_session = std::max(1, options.num_threads / static_cast<int>(num_sessions));
+
+            Ort::SessionOptions session_options;
+            session_options.SetIntraOpNumThreads(threads_per_session);
+            session_options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+
+            // Set execution provider (CUDA or CPU)
+            if (options.device == "cuda") {
+                OrtCUDAProviderOptions cuda_options;
+                cuda_options.device_id = 0;
+                session_options.AppendExecutionProvider_CUDA(cuda_options);
+            }
+
+            // Load embedding model once per pooled session
+            #ifdef _WIN32
+            std::wstring model_path_wide(options.embedding_model_path.begin(),
+                                         options.embedding_model_path.end());
+            #endif
+            sessions_.resize(num_sessions);
+            for (size_t i = 0; i < num_sessions; ++i) {
+                #ifdef _WIN32
+                sessions_[i].session = std::make_unique<Ort::Session>(onnx::shared_env(), model_path_wide.c_str(),
+                                                                      session_options);
+                #else
+                sessions_[i].session = std::make_unique<Ort::Session>(onnx::shared_env(),
+                                                                      options.embedding_model_path.c_str(),
+                                                                      session_options);
+                #endif
+                free_sessions_.push_back(i);
+            }
+
+            Ort::Session& session = *sessions_.front().session;
+
+            // Get input/output metadata
+            Ort::AllocatorWithDefaultOptions allocator;
+
+            // Input shape (pyannote expects: [batch, samples])
+            auto input_shape = session.GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+
+            if (input_shape.size() >= 1 && input_shape[0] > 0) {
+                max_batch_size_ = static_cast<size_t>(input_shape[0]);  // Fixed batch dimension
+            }
+            if (input_shape.size() >= 2 && input_shape[1] > 0) {
+                input_samples_ = static_cast<size_t>(input_shape[1]);
+            }
+
+            // Output dimension, if the model declares it statically ([batch, 512])
+            auto output_shape = session.GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+            if (!output_shape.empty() && output_shape.back() > 0) {
+                dim_ = static_cast<size_t>(output_shape.back());
+            }
+
+            // Input/output names - copied into owned strings (the allocated
+            // pointers are freed when they go out of scope)
+            input_name_ = session.GetInputNameAllocated(0, allocator).get();
+            output_name_ = session.GetOutputNameAllocated(0, allocator).get();
+
+            std::cout << "[Diarizer] Loaded embedding model: " << options.embedding_model_path << "\n";
+            std::cout << "[Diarizer] Device: " << options.device << " (" << num_sessions << " session(s), "
+                      << threads_per_session << " thread(s) each)\n";
+
+        } catch (const Ort::Exception& e) {
+            throw std::runtime_error("Failed to initialize ONNX session: " + std::string(e.what()));
+        }
+
+        // Dynamic-shape models: resolve the output dimension now, so
+        // concurrent calls only ever read it
+        if (dim_ == 0) {
+            std::vector<float> silence(input_samples_, 0.0f);
+            const float* window = silence.data();
+            size_t length = silence.size();
+            embed(&window, &length, 1, nullptr);
+        }
+    }
+
+    size_t input_samples() const override { return input_samples_; }
+    size_t dim() const override { return dim_; }
+    size_t max_batch_size() const override { return max_batch_size_; }
+
+    void embed(const float* const* windows, const size_t* lengths,
+               size_t count, float* output) override {
+        // Lease a pooled session (and its input buffer) for this batch
+        struct SessionLease {
+            OnnxEmbeddingBackend* owner;
+            size_t index;
+            ~SessionLease() { owner->release_session(index); }
+        } lease{this, acquire_session()};
+
+        Ort::Session& session = *sessions_[lease.index].session;
+        std::vector<float>& batch_buffer = sessions_[lease.index].batch_buffer;
+
+        try {
+            Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(
+                OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+
+            // A fixed batch dimension must be filled completely (padding rows are zeros)
+            const size_t run_count = max_batch_size_ > 0 ? max_batch_size_ : count;
+
+            // Pack windows into the reused [run_count, input_samples_] buffer,
+            // padding or truncating each to the model input length
+            batch_buffer.assign(run_count * input_samples_, 0.0f);
+            for (size_t i = 0; i < count; ++i) {
+                size_t copy_size = std::min(lengths[i], input_samples_);
+                std::copy(windows[i], windows[i] + copy_size, batch_buffer.begin() + i * input_samples_);
+            }
+
+            std::vector<int64_t> input_shape = {static_cast<int64_t>(run_count),
+                                                static_cast<int64_t>(input_samples_)};
+            Ort::Value input_tensor = Ort::Value::CreateTensor<float>(
+                memory_info, batch_buffer.data(), batch_buffer.size(),
+                input_shape.data(), input_shape.size());
+
+            const char* input_name = input_name_.c_str();
+            const char* output_name = output_name_.c_str();
+
+            if (dim_ > 0 && output != nullptr && run_count == count) {
+                // Known output shape: write directly into the caller's rows
+                std::vector<int64_t> output_shape = {static_cast<int64_t>(count),
+                                                     static_cast<int64_t>(dim_)};
+                Ort::Value output_tensor = Ort::Value::CreateTensor<float>(
+                    memory_info, output, count * dim_,
+                    output_shape.data(), output_shape.size());
+
+                session.Run(Ort::RunOptions{nullptr},
+                            &input_name, &input_tensor, 1,
+                            &output_name, &output_tensor, 1);
+                return;
+            }
+
+            // Unknown dimension or padded batch: let ORT allocate, then copy
+            auto output_tensors = session.Run(
+                Ort::RunOptions{nullptr},
+                &input_name, &input_tensor, 1,
+                &output_name, 1);
+
+            const float* output_data = output_tensors[0].GetTensorMutableData<float>();
+            auto output_shape = output_tensors[0].GetTensorTypeAndShapeInfo().GetShape();
+            if (dim_ == 0) {
+                dim_ = static_cast<size_t>(output_shape.back());  // Init-time probe
+            }
+
+            if (output != nullptr) {
+                std::copy(output_data, output_data + count * dim_, output);
+            }
+
+        } catch (const Ort::Exception& e) {
+            throw std::runtime_error("ONNX embedding extraction failed: " + std::string(e.what()));
+        }
+    }
+
+private:
+    struct PooledSession {
+        std::unique_ptr<Ort::Session> session;
+        std::vector<float> batch_buffer;    // Reused [B, input_samples_] input
+    };
+    std::vector<PooledSession> sessions_;
+    std::vector<size_t> free_sessions_;     // Indices of idle sessions
+    std::mutex session_mutex_;
+    std::condition_variable session_available_;
+
+    // Model metadata (cached once at session init)
+    std::string input_name_;
+    std::string output_name_;
+    size_t input_samples_ = 16000;          // Samples per window fed to the model
+    size_t max_batch_size_ = 0;             // Fixed model batch dimension (0 = dynamic)
+    size_t dim_ = 0;                        // Output dimension (probed at init if not declared)
+
+    // Blocks until a pooled session is idle
+    size_t acquire_session() {
+        std::unique_lock<std::mutex> lock(session_mutex_);
+        session_available_.wait(lock, [this] { return !free_sessions_.empty(); });
+        size_t index = free_sessions_.back();
+        free_sessions_.pop_back();
+        return index;
+    }
+
+    void release_session(size_t index) {
+        {
+            std::lock_guard<std::mutex> lock(session_mutex_);
+            free_sessions_.push_back(index);
+        }
+        session_available_.notify_one();
+    }
+};
+
+} // anonymous namespace
+
+#endif // MUNINN_USE_SILERO_VAD
+
 // ═══════════════════════════════════════════════════════════
 // Diarizer Implementation
 // ═══════════════════════════════════════════════════════════
@@ -22,67 +238,41 @@ Diarizer::Diarizer(const std::string& embedding_model_path,
 
     options_.embedding_model_path = embedding_model_path;
 
-    // Initialize ONNX Runtime
-    initialize_onnx_session();
-}
+#ifdef MUNINN_USE_SILERO_VAD
+    backend_ = std::make_unique<OnnxEmbeddingBackend>(options_);
+#else
+    throw std::runtime_error("Diarizer requires ONNX Runtime (build with MUNINN_USE_SILERO_VAD)");
+#endif
 
-Diarizer::~Diarizer() {
-    // ONNX Runtime cleanup handled by unique_ptr
+    load_speaker_profiles();
 }
 
-void Diarizer::initialize_onnx_session() {
-    try {
-        // Create ONNX Runtime environment
-        env_ = std::make_unique<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "MuninnDiarizer");
-
-        // Session options
-        session_options_ = std::make_unique<Ort::SessionOptions>();
-        session_options_->SetIntraOpNumThreads(options_.num_threads);
-        session_options_->SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
-
-        // Set execution provider (CUDA or CPU)
-        if (options_.device == "cuda") {
-            OrtCUDAProviderOptions cuda_options;
-            cuda_options.device_id = 0;
-            session_options_->AppendExecutionProvider_CUDA(cuda_options);
-        }
-
-        // Load embedding model
-        #ifdef _WIN32
-        std::wstring model_path_wide(options_.embedding_model_path.begin(),
-                                     options_.embedding_model_path.end());
-        embedding_session_ = std::make_unique<Ort::Session>(*env_, model_path_wide.c_str(),
-                                                            *session_options_);
-        #else
-        embedding_session_ = std::make_unique<Ort::Session>(*env_, options_.embedding_model_path.c_str(),
-                                                            *session_options_);
-        #endif
-
-        // Get input/output metadata
-        Ort::AllocatorWithDefaultOptions allocator;
-
-        // Input shape (pyannote expects: [batch, samples])
-        auto input_info = embedding_session_->GetInputTypeInfo(0);
-        auto tensor_info = input_info.GetTensorTypeAndShapeInfo();
-        input_shape_ = tensor_info.GetShape();
+Diarizer::Diarizer(std::unique_ptr<EmbeddingBackend> backend,
+                   const DiarizationOptions& options)
+    : options_(options)
+    , backend_(std::move(backend)) {
 
-        // Input/output names
-        auto input_name = embedding_session_->GetInputNameAllocated(0, allocator);
-        auto output_name = embedding_session_->GetOutputNameAllocated(0, allocator);
+    if (!backend_) {
+        throw std::runtime_error("Embedding backend cannot be null");
+    }
 
-        input_names_.push_back(input_name.get());
-        output_names_.push_back(output_name.get());
+    load_speaker_profiles();
+}
 
-        std::cout << "[Diarizer] Loaded embedding model: " << options_.embedding_model_path << "\n";
-        std::cout << "[Diarizer] Device: " << options_.device << "\n";
+Diarizer::~Diarizer() {
+    // Embedding backend cleanup handled by unique_ptr
+}
 
-    } catch (const Ort::Exception& e) {
-        throw std::runtime_error("Failed to initialize ONNX session: " + std::string(e.what()));
+void Diarizer::load_speaker_profiles() {
+    // Named speaker profiles (optional)
+    profiles_ = std::make_unique<SpeakerProfileStore>();
+    if (!options_.speaker_profiles_path.empty() && !profiles_->load(options_.speaker_profiles_path)) {
+        std::cerr << "[Diarizer] Warning: speaker profiles not loaded, using generic labels\n";
     }
 }
 
 bool Diarizer::is_ready() const {
-    return embedding_session_ != nullptr;
+    return backend_ != nullptr;
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -101,41 +291,80 @@ DiarizationResult Diarizer::diarize(const float* audio_data,
         throw std::runtime_error("Diarizer not initialized");
     }
 
-    DiarizationResult result;
-
     // Step 1: Extract embeddings with sliding window
-    auto embeddings = extract_embeddings(audio_data, num_samples, sample_rate);
+    EmbeddingMatrix embeddings = extract_embedding_matrix(audio_data, num_samples, sample_rate);
 
     if (embeddings.empty()) {
         std::cerr << "[Diarizer] No embeddings extracted (audio too short?)\n";
-        return result;
+        return DiarizationResult();
+    }
+
+    std::cout << "[Diarizer] Extracted " << embeddings.rows() << " embeddings\n";
+
+    return diarize_embeddings(embeddings);
+}
+
+DiarizationResult Diarizer::diarize(const float* audio_data,
+                                    size_t num_samples,
+                                    const std::vector<SpeechSegment>& speech_segments,
+                                    int sample_rate) {
+    if (sample_rate != 16000) {
+        throw std::runtime_error("Diarization requires 16kHz audio (got " +
+                               std::to_string(sample_rate) + "Hz)");
     }
 
-    std::cout << "[Diarizer] Extracted " << embeddings.size() << " embeddings\n";
+    if (!is_ready()) {
+        throw std::runtime_error("Diarizer not initialized");
+    }
+
+    // Step 1: Extract embeddings inside speech only
+    EmbeddingMatrix embeddings = extract_embedding_matrix(audio_data, num_samples, speech_segments, sample_rate);
+
+    if (embeddings.empty()) {
+        std::cerr << "[Diarizer] No embeddings extracted (no speech long enough?)\n";
+        return DiarizationResult();
+    }
+
+    std::cout << "[Diarizer] Extracted " << embeddings.rows() << " embeddings from "
+              << speech_segments.size() << " speech segments\n";
+
+    return diarize_embeddings(embeddings);
+}
+
+DiarizationResult Diarizer::diarize_embeddings(const EmbeddingMatrix& embeddings) {
+    DiarizationResult result;
 
-    // Step 2: Cluster embeddings into speakers
-    auto speakers = cluster_speakers(embeddings);
+    // Step 2: Cluster embeddings into speakers (labels carried by window index);
+    // windows of known speakers are labelled from the profile store instead
+    std::vector<std::string> label_names;
+    std::vector<int> labels = profiles_->empty() ? cluster_embeddings(embeddings)
+                                                 : cluster_with_profiles(embeddings, label_names);
+    std::vector<int> cluster_labels = labels;
+    auto speakers = build_speakers(embeddings, labels);
 
     std::cout << "[Diarizer] Detected " << speakers.size() << " speakers\n";
 
     // Step 3: Convert to time-aligned segments
-    auto segments = embeddings_to_segments(embeddings, speakers);
+    auto segments = embeddings_to_segments(embeddings, labels);
 
     // Step 4: Merge adjacent segments from same speaker (optional)
     if (options_.merge_adjacent_same_speaker && !segments.empty()) {
         std::vector<DiarizationSegment> merged;
         merged.push_back(segments[0]);
+        int merged_windows = 1;
 
         for (size_t i = 1; i < segments.size(); ++i) {
             auto& last = merged.back();
             auto& curr = segments[i];
 
-            // Merge if same speaker and close in time (< 0.5s gap)
+            // Merge if same speaker and close in time (< 0.5s gap);
+            // confidence is the mean over the merged windows
             if (curr.speaker_id == last.speaker_id && (curr.start - last.end) < 0.5f) {
                 last.end = curr.end;
-                last.confidence = (last.confidence + curr.confidence) / 2.0f;
+                last.confidence += (curr.confidence - last.confidence) / ++merged_windows;
             } else {
                 merged.push_back(curr);
+                merged_windows = 1;
             }
         }
 
@@ -146,50 +375,390 @@ DiarizationResult Diarizer::diarize(const float* audio_data,
     result.speakers = speakers;
     result.num_speakers = speakers.size();
 
+    // Step 5: Names of speakers matched to profiles
+    if (!label_names.empty()) {
+        std::map<int, std::string> names;
+        for (size_t i = 0; i < labels.size(); ++i) {
+            const std::string& name = label_names[cluster_labels[i]];
+            if (!name.empty()) {
+                names[labels[i]] = name;
+            }
+        }
+        set_speaker_labels(result, names);
+
+        for (const auto& [speaker_id, name] : names) {
+            std::cout << "[Diarizer] Speaker " << speaker_id << " identified as " << name << "\n";
+        }
+    }
+
     return result;
 }
 
-int Diarizer::get_speaker_at_time(const DiarizationResult& result, float time_s) {
-    for (const auto& seg : result.segments) {
-        if (time_s >= seg.start && time_s < seg.end) {
-            return seg.speaker_id;
+std::vector<int> Diarizer::cluster_with_profiles(const EmbeddingMatrix& embeddings,
+                                                 std::vector<std::string>& label_names) {
+    label_names.clear();
+    const size_t n = embeddings.rows();
+    const size_t dim = embeddings.dim;
+
+    if (profiles_->dim() != dim) {
+        std::cerr << "[Diarizer] Warning: profile dimension " << profiles_->dim()
+                  << " does not match embeddings (" << dim << "), ignoring profiles\n";
+        return cluster_embeddings(embeddings);
+    }
+
+    EmbeddingMatrix normalized_copy;
+    const EmbeddingMatrix* matrix = &embeddings;
+    if (!embeddings.normalized) {
+        normalized_copy = embeddings;
+        normalized_copy.normalize();
+        matrix = &normalized_copy;
+    }
+
+    const float threshold = options_.profile_match_threshold;
+    std::vector<int> labels(n, -1);
+    std::vector<int> profile_label(profiles_->size(), -1);
+
+    auto label_for_profile = [&](int profile) {
+        if (profile_label[profile] < 0) {
+            profile_label[profile] = static_cast<int>(label_names.size());
+            label_names.push_back(profiles_->name(profile));
+        }
+        return profile_label[profile];
+    };
+
+    // Windows close to a known speaker skip clustering
+    auto hits = profiles_->best_matches(matrix->data.data(), n);
+
+    EmbeddingMatrix unknown;
+    unknown.dim = dim;
+    unknown.normalized = true;
+    std::vector<size_t> unknown_rows;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (hits[i].similarity >= threshold) {
+            labels[i] = label_for_profile(hits[i].index);
+            continue;
+        }
+        unknown_rows.push_back(i);
+        unknown.data.insert(unknown.data.end(), matrix->row(i), matrix->row(i) + dim);
+        unknown.starts.push_back(matrix->starts[i]);
+        unknown.ends.push_back(matrix->ends[i]);
+    }
+
+    std::cout << "[Diarizer] Profiles: " << (n - unknown_rows.size()) << "/" << n
+              << " windows matched known speakers\n";
+
+    if (unknown_rows.empty()) {
+        return labels;
+    }
+
+    // Cluster the rest, then match each new cluster's centroid as a whole
+    std::vector<int> sub_labels = cluster_embeddings(unknown);
+    size_t num_clusters = static_cast<size_t>(*std::max_element(sub_labels.begin(), sub_labels.end())) + 1;
+
+    std::vector<float> centroids(num_clusters * dim, 0.0f);
+    for (size_t r = 0; r < unknown_rows.size(); ++r) {
+        float* centroid = centroids.data() + sub_labels[r] * dim;
+        const float* row = unknown.row(r);
+        for (size_t d = 0; d < dim; ++d) {
+            centroid[d] += row[d];
         }
     }
+    EmbeddingOps::normalize_rows(centroids.data(), num_clusters, dim);
+
+    auto cluster_hits = profiles_->best_matches(centroids.data(), num_clusters);
+    std::vector<int> cluster_label(num_clusters);
+    for (size_t c = 0; c < num_clusters; ++c) {
+        if (cluster_hits[c].similarity >= threshold) {
+            cluster_label[c] = label_for_profile(cluster_hits[c].index);
+        } else {
+            cluster_label[c] = static_cast<int>(label_names.size());
+            label_names.emplace_back();
+        }
+    }
+
+    for (size_t r = 0; r < unknown_rows.size(); ++r) {
+        labels[unknown_rows[r]] = cluster_label[sub_labels[r]];
+    }
+
+    return labels;
+}
+
+int Diarizer::enroll_speaker(const DiarizationResult& result, int speaker_id,
+                             const std::string& name, float new_weight) {
+    for (const auto& speaker : result.speakers) {
+        if (speaker.speaker_id != speaker_id || speaker.embeddings.empty()) {
+            continue;
+        }
+
+        // Centroid of the speaker's (normalised) window embeddings
+        size_t dim = speaker.embeddings[0].features.size();
+        std::vector<float> centroid(dim, 0.0f);
+        for (const auto& emb : speaker.embeddings) {
+            for (size_t d = 0; d < dim && d < emb.features.size(); ++d) {
+                centroid[d] += emb.features[d];
+            }
+        }
+
+        return profiles_->add_profile(name, centroid.data(), dim, new_weight);
+    }
+    return -1;
+}
+
+int Diarizer::get_speaker_at_time(const DiarizationResult& result, float time_s) {
+    // Segments are time-ordered (starts and ends non-decreasing), so the
+    // first segment ending after time_s is the only candidate
+    const auto& segments = result.segments;
+    auto it = std::partition_point(segments.begin(), segments.end(),
+                                   [time_s](const DiarizationSegment& seg) { return seg.end <= time_s; });
+
+    if (it != segments.end() && it->start <= time_s) {
+        return it->speaker_id;
+    }
     return -1;  // No speaker at this time
 }
 
+namespace {
+
+// Per-speaker overlap accumulator; cleared in O(speakers touched)
+struct SpeakerOverlap {
+    std::vector<float> overlap;              // Seconds per speaker
+    std::vector<float> weighted_confidence;  // Overlap-weighted confidence per speaker
+    std::vector<int> touched;
+
+    explicit SpeakerOverlap(size_t num_speakers)
+        : overlap(num_speakers, 0.0f), weighted_confidence(num_speakers, 0.0f) {}
+
+    // Add the diarization segments overlapping [start, end), scanning from `first`
+    void add(const std::vector<DiarizationSegment>& diar_segments, size_t first, float start, float end) {
+        for (size_t j = first; j < diar_segments.size() && diar_segments[j].start < end; ++j) {
+            const auto& diar_seg = diar_segments[j];
+            float amount = std::min(end, diar_seg.end) - std::max(start, diar_seg.start);
+            if (amount <= 0.0f || diar_seg.speaker_id < 0) {
+                continue;
+            }
+            if (overlap[diar_seg.speaker_id] == 0.0f) {
+                touched.push_back(diar_seg.speaker_id);
+            }
+            overlap[diar_seg.speaker_id] += amount;
+            weighted_confidence[diar_seg.speaker_id] += amount * diar_seg.confidence;
+        }
+    }
+
+    // Speaker with the largest overlap (-1 if none) and its mean confidence
+    int best(float& confidence) const {
+        int speaker_id = -1;
+        float best_overlap = 0.0f;
+        for (int id : touched) {
+            if (overlap[id] > best_overlap) {
+                best_overlap = overlap[id];
+                speaker_id = id;
+            }
+        }
+        confidence = speaker_id >= 0 ? weighted_confidence[speaker_id] / best_overlap : 0.0f;
+        return speaker_id;
+    }
+
+    void clear() {
+        for (int id : touched) {
+            overlap[id] = 0.0f;
+            weighted_confidence[id] = 0.0f;
+        }
+        touched.clear();
+    }
+};
+
+// Advance `first` past diarization segments ending at or before `time`
+inline void skip_ended(const std::vector<DiarizationSegment>& diar_segments, size_t& first, float time) {
+    while (first < diar_segments.size() && diar_segments[first].end <= time) {
+        ++first;
+    }
+}
+
+} // anonymous namespace
+
 void Diarizer::assign_speakers_to_segments(std::vector<Segment>& segments,
-                                          const DiarizationResult& diarization) {
-    for (auto& seg : segments) {
-        // Get speaker at segment midpoint
-        float midpoint = (seg.start + seg.end) / 2.0f;
-        int speaker_id = get_speaker_at_time(diarization, midpoint);
+                                          const DiarizationResult& diarization,
+                                          int track_id) {
+    const auto& diar_segments = diarization.segments;
+    if (diar_segments.empty()) {
+        return;
+    }
+
+    // Speaker labels by ID (custom labels from set_speaker_labels take precedence)
+    int max_speaker_id = -1;
+    for (const auto& diar_seg : diar_segments) {
+        max_speaker_id = std::max(max_speaker_id, diar_seg.speaker_id);
+    }
+    for (const auto& speaker : diarization.speakers) {
+        max_speaker_id = std::max(max_speaker_id, speaker.speaker_id);
+    }
+    if (max_speaker_id < 0) {
+        return;
+    }
+
+    std::vector<std::string> labels(max_speaker_id + 1);
+    for (const auto& speaker : diarization.speakers) {
+        if (speaker.speaker_id >= 0) {
+            labels[speaker.speaker_id] = speaker.label;
+        }
+    }
+
+    // Visit transcript segments in start order for the two-pointer sweep
+    std::vector<size_t> order;
+    order.reserve(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (track_id < 0 || segments[i].track_id == track_id) {
+            order.push_back(i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&segments](size_t a, size_t b) {
+        return segments[a].start < segments[b].start;
+    });
+
+    SpeakerOverlap accumulator(max_speaker_id + 1);
+
+    size_t first = 0;
+    for (size_t idx : order) {
+        auto& seg = segments[idx];
+
+        // Diarization segments ending before this one starts never overlap a later one either
+        skip_ended(diar_segments, first, seg.start);
+
+        // Segment: speaker with the largest overlap
+        float confidence = 0.0f;
+        accumulator.add(diar_segments, first, seg.start, seg.end);
+        int speaker_id = accumulator.best(confidence);
+        accumulator.clear();
 
         seg.speaker_id = speaker_id;
 
         if (speaker_id >= 0) {
-            // Find speaker label
-            for (const auto& speaker : diarization.speakers) {
-                if (speaker.speaker_id == speaker_id) {
-                    seg.speaker_label = speaker.label;
-                    break;
-                }
-            }
+            seg.speaker_label = labels[speaker_id];
 
             // If no custom label, use default
             if (seg.speaker_label.empty()) {
                 seg.speaker_label = "Speaker " + std::to_string(speaker_id);
             }
 
-            // Find confidence
-            for (const auto& diar_seg : diarization.segments) {
-                if (midpoint >= diar_seg.start && midpoint < diar_seg.end) {
-                    seg.speaker_confidence = diar_seg.confidence;
+            seg.speaker_confidence = confidence;
+        }
+
+        // Words: the same sweep, continued from the segment's position
+        // (word times are ordered within a segment)
+        size_t word_first = first;
+        int previous_speaker = -1;
+        for (auto& word : seg.words) {
+            skip_ended(diar_segments, word_first, word.start);
+
+            float word_confidence = 0.0f;
+            accumulator.add(diar_segments, word_first, word.start, word.end);
+            word.speaker_id = accumulator.best(word_confidence);
+            accumulator.clear();
+
+            // Words in gaps between diarization segments keep the running speaker
+            if (word.speaker_id < 0) {
+                word.speaker_id = previous_speaker;
+            }
+            previous_speaker = word.speaker_id;
+        }
+
+        // Leading words before the first attributed one take the next speaker
+        int next_speaker = speaker_id;
+        for (auto it = seg.words.rbegin(); it != seg.words.rend(); ++it) {
+            if (it->speaker_id >= 0) {
+                next_speaker = it->speaker_id;
+            } else {
+                it->speaker_id = next_speaker;
+            }
+        }
+    }
+}
+
+void Diarizer::split_segments_by_speaker(std::vector<Segment>& segments,
+                                        const DiarizationResult& diarization,
+                                        int track_id) {
+    auto label_for = [&diarization](int speaker_id) {
+        for (const auto& speaker : diarization.speakers) {
+            if (speaker.speaker_id == speaker_id && !speaker.label.empty()) {
+                return speaker.label;
+            }
+        }
+        return "Speaker " + std::to_string(speaker_id);
+    };
+
+    // Per-run confidence from the diarization segments overlapping it
+    int max_speaker_id = -1;
+    for (const auto& diar_seg : diarization.segments) {
+        max_speaker_id = std::max(max_speaker_id, diar_seg.speaker_id);
+    }
+    SpeakerOverlap accumulator(max_speaker_id + 1);
+
+    std::vector<Segment> result;
+    result.reserve(segments.size());
+
+    for (auto& seg : segments) {
+        bool has_change = false;
+        if (track_id < 0 || seg.track_id == track_id) {
+            for (size_t w = 1; w < seg.words.size(); ++w) {
+                if (seg.words[w].speaker_id != seg.words[w - 1].speaker_id) {
+                    has_change = true;
                     break;
                 }
             }
         }
+
+        if (!has_change) {
+            result.push_back(std::move(seg));
+            continue;
+        }
+
+        // One piece per run of words with the same speaker
+        size_t run_begin = 0;
+        while (run_begin < seg.words.size()) {
+            size_t run_end = run_begin + 1;
+            while (run_end < seg.words.size() &&
+                   seg.words[run_end].speaker_id == seg.words[run_begin].speaker_id) {
+                ++run_end;
+            }
+
+            Segment piece = seg;
+            piece.words.assign(seg.words.begin() + run_begin, seg.words.begin() + run_end);
+            piece.start = run_begin == 0 ? seg.start : piece.words.front().start;
+            piece.end = run_end == seg.words.size() ? seg.end : piece.words.back().end;
+            piece.translated_text.clear();
+
+            piece.text.clear();
+            for (const auto& word : piece.words) {
+                if (!piece.text.empty() && !word.word.empty() &&
+                    !std::isspace(static_cast<unsigned char>(word.word.front()))) {
+                    piece.text += ' ';
+                }
+                piece.text += word.word;
+            }
+
+            piece.speaker_id = piece.words.front().speaker_id;
+            piece.speaker_label = piece.speaker_id >= 0 ? label_for(piece.speaker_id) : std::string();
+            if (piece.speaker_id >= 0 && piece.speaker_id <= max_speaker_id) {
+                // Time-ordered diarization segments: binary search for the first one still open
+                auto open = std::partition_point(
+                    diarization.segments.begin(), diarization.segments.end(),
+                    [&piece](const DiarizationSegment& d) { return d.end <= piece.start; });
+                accumulator.add(diarization.segments, open - diarization.segments.begin(),
+                                piece.start, piece.end);
+                float speaker_overlap = accumulator.overlap[piece.speaker_id];
+                piece.speaker_confidence = speaker_overlap > 0.0f
+                    ? accumulator.weighted_confidence[piece.speaker_id] / speaker_overlap
+                    : seg.speaker_confidence;
+                accumulator.clear();
+            }
+
+            result.push_back(std::move(piece));
+            run_begin = run_end;
+        }
     }
+
+    segments = std::move(result);
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -210,77 +779,433 @@ SpeakerEmbedding Diarizer::extract_embedding(const float* audio_data, size_t num
 std::vector<SpeakerEmbedding> Diarizer::extract_embeddings(const float* audio_data,
                                                            size_t num_samples,
                                                            int sample_rate) {
-    std::vector<SpeakerEmbedding> embeddings;
+    EmbeddingMatrix matrix = extract_embedding_matrix(audio_data, num_samples, sample_rate);
+
+    std::vector<SpeakerEmbedding> embeddings(matrix.rows());
+    for (size_t i = 0; i < matrix.rows(); ++i) {
+        embeddings[i].features.assign(matrix.row(i), matrix.row(i) + matrix.dim);
+        embeddings[i].start = matrix.starts[i];
+        embeddings[i].end = matrix.ends[i];
+    }
+
+    return embeddings;
+}
 
+EmbeddingMatrix Diarizer::extract_embedding_matrix(const float* audio_data,
+                                                   size_t num_samples,
+                                                   int sample_rate) {
     const size_t window_samples = static_cast<size_t>(options_.embedding_window_s * sample_rate);
-    const size_t step_samples = static_cast<size_t>(options_.embedding_step_s * sample_rate);
+    size_t step_samples = static_cast<size_t>(options_.embedding_step_s * sample_rate);
+    if (window_samples == 0 || num_samples < window_samples) {
+        return EmbeddingMatrix();
+    }
+    if (step_samples == 0) {
+        step_samples = window_samples;
+    }
 
-    size_t pos = 0;
-    while (pos + window_samples <= num_samples) {
-        SpeakerEmbedding emb = extract_embedding(audio_data + pos, window_samples);
+    // Window i covers [i * step, i * step + window) - strided views into the track
+    const size_t num_windows = (num_samples - window_samples) / step_samples + 1;
+
+    std::vector<size_t> offsets(num_windows);
+    std::vector<size_t> lengths(num_windows, window_samples);
+    std::vector<float> starts(num_windows);
+    std::vector<float> ends(num_windows);
+    for (size_t i = 0; i < num_windows; ++i) {
+        offsets[i] = i * step_samples;
+        starts[i] = static_cast<float>(offsets[i]) / sample_rate;
+        ends[i] = static_cast<float>(offsets[i] + window_samples) / sample_rate;
+    }
+
+    return embed_windows(audio_data, offsets, lengths, std::move(starts), std::move(ends));
+}
+
+EmbeddingMatrix Diarizer::extract_embedding_matrix(const float* audio_data,
+                                                   size_t num_samples,
+                                                   const std::vector<SpeechSegment>& speech_segments,
+                                                   int sample_rate) {
+    const size_t window_samples = static_cast<size_t>(options_.embedding_window_s * sample_rate);
+    size_t step_samples = static_cast<size_t>(options_.embedding_step_s * sample_rate);
+    const size_t min_samples = static_cast<size_t>(options_.min_segment_duration * sample_rate);
+    if (window_samples == 0 || num_samples == 0) {
+        return EmbeddingMatrix();
+    }
+    if (step_samples == 0) {
+        step_samples = window_samples;
+    }
+
+    std::vector<size_t> offsets;
+    std::vector<size_t> lengths;
+    std::vector<float> starts;
+    std::vector<float> ends;
+
+    auto add_window = [&](size_t offset, size_t length, float start, float end) {
+        offsets.push_back(offset);
+        lengths.push_back(length);
+        starts.push_back(start);
+        ends.push_back(end);
+    };
 
-        emb.start = static_cast<float>(pos) / sample_rate;
-        emb.end = static_cast<float>(pos + window_samples) / sample_rate;
+    for (const auto& seg : speech_segments) {
+        size_t seg_start = std::min(num_samples, static_cast<size_t>(std::max(0.0f, seg.start) * sample_rate));
+        size_t seg_end = std::min(num_samples, static_cast<size_t>(std::max(0.0f, seg.end) * sample_rate));
+        if (seg_end <= seg_start || seg_end - seg_start < std::max<size_t>(min_samples, 1)) {
+            continue;  // Too short to attribute
+        }
 
-        embeddings.push_back(emb);
+        if (seg_end - seg_start < window_samples) {
+            // Short speech run: one window centred on it (padded only at the track edges),
+            // attributed to the speech run itself
+            size_t centre = (seg_start + seg_end) / 2;
+            size_t offset = centre > window_samples / 2 ? centre - window_samples / 2 : 0;
+            if (num_samples >= window_samples) {
+                offset = std::min(offset, num_samples - window_samples);
+            }
+            add_window(offset, std::min(window_samples, num_samples - offset),
+                       static_cast<float>(seg_start) / sample_rate,
+                       static_cast<float>(seg_end) / sample_rate);
+            continue;
+        }
 
-        pos += step_samples;
+        // Sliding windows inside the run, plus one aligned to its end so the tail is covered
+        size_t pos = seg_start;
+        for (; pos + window_samples <= seg_end; pos += step_samples) {
+            add_window(pos, window_samples,
+                       static_cast<float>(pos) / sample_rate,
+                       static_cast<float>(pos + window_samples) / sample_rate);
+        }
+        size_t last = pos - step_samples;
+        if (last + window_samples < seg_end) {
+            add_window(seg_end - window_samples, window_samples,
+                       static_cast<float>(seg_end - window_samples) / sample_rate,
+                       static_cast<float>(seg_end) / sample_rate);
+        }
     }
 
-    return embeddings;
+    if (offsets.empty()) {
+        return EmbeddingMatrix();
+    }
+
+    return embed_windows(audio_data, offsets, lengths, std::move(starts), std::move(ends));
+}
+
+EmbeddingMatrix Diarizer::embed_windows(const float* audio_data,
+                                        const std::vector<size_t>& offsets,
+                                        const std::vector<size_t>& lengths,
+                                        std::vector<float> starts,
+                                        std::vector<float> ends) {
+    EmbeddingMatrix matrix;
+    const size_t num_windows = offsets.size();
+    matrix.starts = std::move(starts);
+    matrix.ends = std::move(ends);
+
+    matrix.dim = backend_->dim();
+    matrix.data.resize(num_windows * matrix.dim);
+
+    size_t batch_size = static_cast<size_t>(std::max(1, options_.embedding_batch_size));
+    if (backend_->max_batch_size() > 0) {
+        batch_size = std::min(batch_size, backend_->max_batch_size());
+    }
+
+    std::vector<const float*> windows(batch_size);
+
+    for (size_t first = 0; first < num_windows; first += batch_size) {
+        size_t count = std::min(batch_size, num_windows - first);
+        for (size_t i = 0; i < count; ++i) {
+            windows[i] = audio_data + offsets[first + i];
+        }
+        backend_->embed(windows.data(), lengths.data() + first, count, matrix.row(first));
+    }
+
+    // Unit rows: cosine similarity becomes a dot product
+    matrix.normalize();
+
+    return matrix;
 }
 
 std::vector<float> Diarizer::run_embedding_model(const float* audio_data, size_t num_samples) {
-    try {
-        Ort::AllocatorWithDefaultOptions allocator;
-        Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(
-            OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+    std::vector<float> embedding(backend_->dim());
+    backend_->embed(&audio_data, &num_samples, 1, embedding.data());
+    return embedding;
+}
 
-        // This model expects exactly [1, 16000] shape (1 second of audio)
-        // Pad or truncate to 16000 samples
-        const size_t expected_samples = 16000;
-        std::vector<float> input_data(expected_samples, 0.0f);
 
-        size_t copy_size = std::min(num_samples, expected_samples);
-        std::copy(audio_data, audio_data + copy_size, input_data.begin());
+// ═══════════════════════════════════════════════════════════
+// Speaker Clustering
+// ═══════════════════════════════════════════════════════════
 
-        // Shape: [batch=1, num_samples=16000]
-        std::vector<int64_t> input_shape = {1, 16000};
+namespace {
 
-        Ort::Value input_tensor = Ort::Value::CreateTensor<float>(
-            memory_info, input_data.data(), input_data.size(),
-            input_shape.data(), input_shape.size());
+// Position of pair (i, j), i != j, in a condensed upper-triangle matrix of n rows
+inline size_t condensed_index(size_t n, size_t i, size_t j) {
+    if (i > j) {
+        std::swap(i, j);
+    }
+    return i * n - i * (i + 1) / 2 + (j - i - 1);
+}
 
-        // Use "waveform" as the input name (from our ONNX conversion script)
-        const char* input_name = "waveform";
+/**
+ * @brief Condensed all-pairs similarity of normalised rows
+ *
+ * Computed in row blocks through the SIMD kernel, so the only scratch is
+ * one [64, n] block instead of the full n x n matrix.
+ */
+std::vector<float> condensed_similarity(const float* data, size_t n, size_t dim) {
+    constexpr size_t kRowBlock = 64;
+    std::vector<float> condensed(n * (n - 1) / 2);
+    std::vector<float> block(kRowBlock * n);
+
+    for (size_t i0 = 0; i0 < n; i0 += kRowBlock) {
+        size_t rows = std::min(kRowBlock, n - i0);
+        size_t cols = n - i0;
+        EmbeddingOps::similarity_block(data + i0 * dim, rows, data + i0 * dim, cols,
+                                       dim, block.data(), cols);
+
+        for (size_t r = 0; r < rows; ++r) {
+            size_t i = i0 + r;
+            if (i + 1 < n) {
+                std::copy(block.begin() + r * cols + r + 1, block.begin() + r * cols + cols,
+                          condensed.begin() + condensed_index(n, i, i + 1));
+            }
+        }
+    }
+
+    return condensed;
+}
 
-        // Get output name dynamically (this model may have different output names)
-        auto output_name_ort = embedding_session_->GetOutputNameAllocated(0, allocator);
-        const char* output_name = output_name_ort.get();
+struct ClusterMerge {
+    size_t keep;        // Surviving cluster slot
+    size_t absorbed;    // Slot merged into keep
+    float similarity;   // Average-linkage similarity at merge time
+};
+
+/**
+ * @brief Average-linkage dendrogram by nearest-neighbour chain
+ *
+ * O(n^2) time on the condensed similarity matrix, which is updated in place
+ * with the Lance-Williams rule
+ *   s(k, a+b) = (n_a * s(k, a) + n_b * s(k, b)) / (n_a + n_b)
+ * Average linkage is reducible, so sorting the n-1 merges by decreasing
+ * similarity gives the same dendrogram as greedy best-pair merging.
+ *
+ * @param similarity Condensed pair similarities (modified)
+ * @param sizes Initial cluster weights (1 per embedding, or k-means counts)
+ */
+std::vector<ClusterMerge> average_linkage(std::vector<float>& similarity, std::vector<double> sizes) {
+    const size_t n = sizes.size();
+    std::vector<ClusterMerge> merges;
+    if (n < 2) {
+        return merges;
+    }
+    merges.reserve(n - 1);
 
-        // Run inference
-        auto output_tensors = embedding_session_->Run(
-            Ort::RunOptions{nullptr},
-            &input_name, &input_tensor, 1,
-            &output_name, 1);
+    std::vector<char> active(n, 1);
+    std::vector<size_t> chain;
+    chain.reserve(n);
+    size_t first_active = 0;
+
+    while (merges.size() + 1 < n) {
+        if (chain.empty()) {
+            while (!active[first_active]) {
+                ++first_active;
+            }
+            chain.push_back(first_active);
+        }
+
+        // Nearest (most similar) neighbour of the chain tip; ties prefer the
+        // previous chain element so the chain always terminates
+        size_t tip = chain.back();
+        size_t prev = chain.size() >= 2 ? chain[chain.size() - 2] : n;
+        size_t best = prev;
+        float best_similarity = prev < n ? similarity[condensed_index(n, tip, prev)]
+                                         : -std::numeric_limits<float>::infinity();
+
+        for (size_t c = 0; c < n; ++c) {
+            if (!active[c] || c == tip) {
+                continue;
+            }
+            float sim = similarity[condensed_index(n, tip, c)];
+            if (sim > best_similarity) {
+                best_similarity = sim;
+                best = c;
+            }
+        }
+
+        if (best != prev) {
+            chain.push_back(best);
+            continue;
+        }
 
-        // Extract output (should be [1, embedding_dim] for pyannote)
-        float* output_data = output_tensors[0].GetTensorMutableData<float>();
-        auto output_shape = output_tensors[0].GetTensorTypeAndShapeInfo().GetShape();
+        // Reciprocal nearest neighbours: merge
+        chain.pop_back();
+        chain.pop_back();
 
-        size_t embedding_size = output_shape.back();  // Embedding dimension
-        std::vector<float> embedding(output_data, output_data + embedding_size);
+        size_t keep = std::min(tip, prev);
+        size_t absorbed = std::max(tip, prev);
+        double total = sizes[keep] + sizes[absorbed];
 
-        return embedding;
+        for (size_t k = 0; k < n; ++k) {
+            if (!active[k] || k == keep || k == absorbed) {
+                continue;
+            }
+            float& sim_keep = similarity[condensed_index(n, k, keep)];
+            float sim_absorbed = similarity[condensed_index(n, k, absorbed)];
+            sim_keep = static_cast<float>((sizes[keep] * sim_keep + sizes[absorbed] * sim_absorbed) / total);
+        }
 
-    } catch (const Ort::Exception& e) {
-        throw std::runtime_error("ONNX embedding extraction failed: " + std::string(e.what()));
+        sizes[keep] = total;
+        active[absorbed] = 0;
+        merges.push_back({keep, absorbed, best_similarity});
     }
+
+    std::stable_sort(merges.begin(), merges.end(),
+                     [](const ClusterMerge& a, const ClusterMerge& b) {
+                         return a.similarity > b.similarity;
+                     });
+    return merges;
 }
 
-// ═══════════════════════════════════════════════════════════
-// Speaker Clustering
-// ═══════════════════════════════════════════════════════════
+/**
+ * @brief Flat clusters from a sorted dendrogram
+ *
+ * Applies merges while similarity >= threshold, then keeps merging the most
+ * similar pair until at most max_clusters remain (0 = unlimited).
+ * Labels are numbered by first occurrence.
+ */
+std::vector<int> cut_dendrogram(const std::vector<ClusterMerge>& merges, size_t n,
+                                float threshold, int max_clusters) {
+    std::vector<size_t> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](size_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+
+    size_t clusters = n;
+    for (const auto& merge : merges) {
+        bool over_limit = max_clusters > 0 && clusters > static_cast<size_t>(max_clusters);
+        if (merge.similarity < threshold && !over_limit) {
+            break;
+        }
+        parent[find(merge.absorbed)] = find(merge.keep);
+        --clusters;
+    }
+
+    std::vector<int> labels(n);
+    std::vector<int> root_label(n, -1);
+    int next_label = 0;
+    for (size_t i = 0; i < n; ++i) {
+        size_t root = find(i);
+        if (root_label[root] < 0) {
+            root_label[root] = next_label++;
+        }
+        labels[i] = root_label[root];
+    }
+    return labels;
+}
+
+/**
+ * @brief Mini-batch k-means (spherical) pre-clustering
+ *
+ * Centroids start at evenly spaced windows and are updated per sample with
+ * a 1/count learning rate. After the final full assignment, means holds the
+ * (unnormalised) mean of each non-empty cluster's rows and counts its size;
+ * the dot product of two such means is exactly the average pairwise cosine
+ * similarity between the clusters.
+ *
+ * @return Pre-cluster index per row
+ */
+std::vector<int> minibatch_kmeans(const EmbeddingMatrix& matrix, size_t k, size_t batch_size,
+                                  int iterations, std::vector<float>& means,
+                                  std::vector<double>& counts) {
+    const size_t n = matrix.rows();
+    const size_t dim = matrix.dim;
+    k = std::min(k, n);
+    batch_size = std::max<size_t>(1, std::min(batch_size, n));
+
+    std::vector<float> centroids(k * dim);
+    for (size_t c = 0; c < k; ++c) {
+        const float* src = matrix.row(c * n / k);
+        std::copy(src, src + dim, centroids.begin() + c * dim);
+    }
+
+    std::vector<double> seen(k, 0.0);
+    std::vector<float> batch(batch_size * dim);
+    std::vector<size_t> batch_rows(batch_size);
+    std::vector<float> scores(batch_size * k);
+    std::mt19937 rng(12345);  // Fixed seed: diarization is deterministic
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+
+    auto nearest = [&](size_t row) {
+        const float* s = scores.data() + row * k;
+        return static_cast<size_t>(std::max_element(s, s + k) - s);
+    };
+
+    for (int it = 0; it < iterations; ++it) {
+        for (size_t b = 0; b < batch_size; ++b) {
+            batch_rows[b] = pick(rng);
+            std::copy(matrix.row(batch_rows[b]), matrix.row(batch_rows[b]) + dim, batch.begin() + b * dim);
+        }
+        EmbeddingOps::similarity_block(batch.data(), batch_size, centroids.data(), k,
+                                       dim, scores.data(), k);
+
+        for (size_t b = 0; b < batch_size; ++b) {
+            size_t c = nearest(b);
+            float eta = static_cast<float>(1.0 / ++seen[c]);
+            float* centroid = centroids.data() + c * dim;
+            const float* x = batch.data() + b * dim;
+            for (size_t d = 0; d < dim; ++d) {
+                centroid[d] += eta * (x[d] - centroid[d]);
+            }
+            EmbeddingOps::normalize(centroid, dim);
+        }
+    }
+
+    // Final assignment of every row, accumulating cluster means
+    std::vector<int> assignment(n);
+    std::vector<float> sums(k * dim, 0.0f);
+    std::vector<double> sizes(k, 0.0);
+
+    for (size_t start = 0; start < n; start += batch_size) {
+        size_t count = std::min(batch_size, n - start);
+        EmbeddingOps::similarity_block(matrix.row(start), count, centroids.data(), k,
+                                       dim, scores.data(), k);
+        for (size_t r = 0; r < count; ++r) {
+            size_t c = nearest(r);
+            assignment[start + r] = static_cast<int>(c);
+            sizes[c] += 1.0;
+            const float* x = matrix.row(start + r);
+            float* sum = sums.data() + c * dim;
+            for (size_t d = 0; d < dim; ++d) {
+                sum[d] += x[d];
+            }
+        }
+    }
+
+    // Drop empty clusters and renumber
+    std::vector<int> remap(k, -1);
+    means.clear();
+    counts.clear();
+    for (size_t c = 0; c < k; ++c) {
+        if (sizes[c] == 0.0) {
+            continue;
+        }
+        remap[c] = static_cast<int>(counts.size());
+        counts.push_back(sizes[c]);
+        for (size_t d = 0; d < dim; ++d) {
+            means.push_back(static_cast<float>(sums[c * dim + d] / sizes[c]));
+        }
+    }
+    for (auto& a : assignment) {
+        a = remap[a];
+    }
+
+    return assignment;
+}
+
+} // anonymous namespace
 
 float Diarizer::cosine_similarity(const SpeakerEmbedding& emb1,
                                  const SpeakerEmbedding& emb2) {
@@ -288,21 +1213,78 @@ float Diarizer::cosine_similarity(const SpeakerEmbedding& emb1,
         throw std::runtime_error("Embedding size mismatch");
     }
 
-    float dot_product = 0.0f;
-    float norm1 = 0.0f;
-    float norm2 = 0.0f;
+    const float* a = emb1.features.data();
+    const float* b = emb2.features.data();
+    size_t dim = emb1.features.size();
 
-    for (size_t i = 0; i < emb1.features.size(); ++i) {
-        dot_product += emb1.features[i] * emb2.features[i];
-        norm1 += emb1.features[i] * emb1.features[i];
-        norm2 += emb2.features[i] * emb2.features[i];
-    }
+    float norm1 = EmbeddingOps::dot(a, a, dim);
+    float norm2 = EmbeddingOps::dot(b, b, dim);
 
     if (norm1 == 0.0f || norm2 == 0.0f) {
         return 0.0f;
     }
 
-    return dot_product / (std::sqrt(norm1) * std::sqrt(norm2));
+    return EmbeddingOps::dot(a, b, dim) / (std::sqrt(norm1) * std::sqrt(norm2));
+}
+
+std::vector<int> Diarizer::cluster_embeddings(const EmbeddingMatrix& embeddings) {
+    const size_t n = embeddings.rows();
+    if (n == 0) {
+        return {};
+    }
+
+    // Cosine similarity = dot product needs unit rows
+    EmbeddingMatrix normalized_copy;
+    const EmbeddingMatrix* matrix = &embeddings;
+    if (!embeddings.normalized) {
+        normalized_copy = embeddings;
+        normalized_copy.normalize();
+        matrix = &normalized_copy;
+    }
+
+    // clustering_threshold is the MINIMUM average cosine similarity to merge clusters
+    // Lower threshold (e.g. 0.3) = merge more aggressively = fewer speakers
+    // Higher threshold (e.g. 0.8) = merge conservatively = more speakers
+    const float merge_threshold = options_.clustering_threshold;
+    const size_t dim = matrix->dim;
+
+    if (options_.ahc_max_embeddings <= 0 || n <= static_cast<size_t>(options_.ahc_max_embeddings)) {
+        std::cout << "[Diarizer] Clustering " << n << " embeddings with threshold " << merge_threshold << "\n";
+
+        std::vector<float> similarity = condensed_similarity(matrix->data.data(), n, dim);
+        auto merges = average_linkage(similarity, std::vector<double>(n, 1.0));
+        return cut_dendrogram(merges, n, merge_threshold, options_.max_speakers);
+    }
+
+    // Two-stage: mini-batch k-means pre-clusters, then average linkage on
+    // their means weighted by cluster size
+    std::vector<float> means;
+    std::vector<double> counts;
+    std::vector<int> assignment = minibatch_kmeans(
+        *matrix, static_cast<size_t>(std::max(1, options_.kmeans_clusters)),
+        static_cast<size_t>(std::max(1, options_.kmeans_batch_size)),
+        options_.kmeans_iterations, means, counts);
+
+    const size_t k = counts.size();
+    std::cout << "[Diarizer] Clustering " << n << " embeddings via " << k
+              << " k-means pre-clusters with threshold " << merge_threshold << "\n";
+
+    std::vector<float> similarity = condensed_similarity(means.data(), k, dim);
+    auto merges = average_linkage(similarity, counts);
+    std::vector<int> cluster_of = cut_dendrogram(merges, k, merge_threshold, options_.max_speakers);
+
+    // Map back to windows and renumber by first occurrence
+    std::vector<int> labels(n);
+    std::vector<int> renumber(k, -1);
+    int next_label = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int cluster = cluster_of[assignment[i]];
+        if (renumber[cluster] < 0) {
+            renumber[cluster] = next_label++;
+        }
+        labels[i] = renumber[cluster];
+    }
+    return labels;
 }
 
 std::vector<Speaker> Diarizer::cluster_speakers(const std::vector<SpeakerEmbedding>& embeddings) {
@@ -312,200 +1294,413 @@ std::vector<Speaker> Diarizer::cluster_speakers(const std::vector<SpeakerEmbeddi
         return speakers;
     }
 
-    // Hierarchical agglomerative clustering with average linkage
-    std::vector<int> cluster_labels(embeddings.size(), -1);
-    std::vector<std::vector<size_t>> clusters;  // Track which embeddings are in each cluster
+    // Pack into one contiguous [N, D] matrix
+    const size_t n = embeddings.size();
+    EmbeddingMatrix matrix;
+    matrix.dim = embeddings[0].features.size();
+    matrix.data.resize(n * matrix.dim);
+    matrix.starts.resize(n);
+    matrix.ends.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (embeddings[i].features.size() != matrix.dim) {
+            throw std::runtime_error("Embedding size mismatch");
+        }
+        std::copy(embeddings[i].features.begin(), embeddings[i].features.end(), matrix.row(i));
+        matrix.starts[i] = embeddings[i].start;
+        matrix.ends[i] = embeddings[i].end;
+    }
+    matrix.normalize();
 
-    // Start with each embedding in its own cluster
-    for (size_t i = 0; i < embeddings.size(); ++i) {
-        cluster_labels[i] = i;
-        clusters.push_back({i});
+    std::vector<int> cluster_labels = cluster_embeddings(matrix);
+    return build_speakers(matrix, cluster_labels);
+}
+
+std::vector<Speaker> Diarizer::build_speakers(const EmbeddingMatrix& embeddings,
+                                              std::vector<int>& labels) {
+    std::vector<Speaker> speakers;
+    if (labels.empty()) {
+        return speakers;
     }
 
-    // Iteratively merge clusters with high average similarity
-    // clustering_threshold is the MINIMUM cosine similarity to merge clusters
-    // Lower threshold (e.g. 0.3) = merge more aggressively = fewer speakers
-    // Higher threshold (e.g. 0.8) = merge conservatively = more speakers
-    const float merge_threshold = options_.clustering_threshold;
+    int max_label = *std::max_element(labels.begin(), labels.end());
+    speakers.resize(max_label + 1);
 
-    std::cout << "[Diarizer] Clustering " << embeddings.size() << " embeddings with threshold " << merge_threshold << "\n";
-
-    bool merged = true;
-    int iteration = 0;
-    while (merged && clusters.size() > 1) {
-        merged = false;
-        float best_similarity = -1.0f;
-        size_t best_i = 0, best_j = 0;
-
-        // Find pair of clusters with highest average similarity
-        for (size_t i = 0; i < clusters.size(); ++i) {
-            for (size_t j = i + 1; j < clusters.size(); ++j) {
-                // Compute average similarity between all pairs
-                float total_similarity = 0.0f;
-                size_t pair_count = 0;
-
-                for (size_t idx_i : clusters[i]) {
-                    for (size_t idx_j : clusters[j]) {
-                        total_similarity += cosine_similarity(embeddings[idx_i], embeddings[idx_j]);
-                        pair_count++;
-                    }
-                }
+    for (int label = 0; label <= max_label; ++label) {
+        speakers[label].speaker_id = label;
+    }
 
-                float avg_similarity = total_similarity / pair_count;
+    // Collect embeddings per speaker in one pass
+    for (size_t i = 0; i < labels.size(); ++i) {
+        Speaker& speaker = speakers[labels[i]];
 
-                if (avg_similarity > best_similarity && avg_similarity >= merge_threshold) {
-                    best_similarity = avg_similarity;
-                    best_i = i;
-                    best_j = j;
-                    merged = true;
-                }
-            }
-        }
+        SpeakerEmbedding embedding;
+        embedding.features.assign(embeddings.row(i), embeddings.row(i) + embeddings.dim);
+        embedding.start = embeddings.starts[i];
+        embedding.end = embeddings.ends[i];
+
+        speaker.embeddings.push_back(std::move(embedding));
+        speaker.total_duration += embeddings.ends[i] - embeddings.starts[i];
+    }
+
+    // Sort by total duration (most active speaker first)
+    std::stable_sort(speakers.begin(), speakers.end(),
+                     [](const Speaker& a, const Speaker& b) {
+                         return a.total_duration > b.total_duration;
+                     });
+
+    // Reassign speaker IDs based on duration, and carry them back to the labels
+    std::vector<int> new_id(max_label + 1);
+    for (size_t i = 0; i < speakers.size(); ++i) {
+        new_id[speakers[i].speaker_id] = static_cast<int>(i);
+        speakers[i].speaker_id = i;
+        speakers[i].label = "Speaker " + std::to_string(i);
+    }
+    for (auto& label : labels) {
+        label = new_id[label];
+    }
 
-        if (merged && iteration < 5) {  // Show first few merges
-            std::cout << "[Diarizer] Iteration " << iteration << ": Merging clusters (similarity: "
-                      << best_similarity << "), " << clusters.size() << " -> " << (clusters.size() - 1) << " clusters\n";
+    return speakers;
+}
+
+std::vector<DiarizationSegment> Diarizer::embeddings_to_segments(
+    const EmbeddingMatrix& embeddings,
+    const std::vector<int>& labels) {
+
+    std::vector<DiarizationSegment> segments;
+    segments.reserve(labels.size());
+
+    if (labels.empty()) {
+        return segments;
+    }
+
+    EmbeddingMatrix normalized_copy;
+    const EmbeddingMatrix* matrix = &embeddings;
+    if (!embeddings.normalized) {
+        normalized_copy = embeddings;
+        normalized_copy.normalize();
+        matrix = &normalized_copy;
+    }
+
+    // Speaker centroids: normalised mean of their unit rows
+    const size_t dim = matrix->dim;
+    const int num_speakers = *std::max_element(labels.begin(), labels.end()) + 1;
+    std::vector<float> centroids(static_cast<size_t>(num_speakers) * dim, 0.0f);
+    for (size_t i = 0; i < labels.size(); ++i) {
+        const float* row = matrix->row(i);
+        float* centroid = centroids.data() + labels[i] * dim;
+        for (size_t d = 0; d < dim; ++d) {
+            centroid[d] += row[d];
         }
-        iteration++;
+    }
+    EmbeddingOps::normalize_rows(centroids.data(), num_speakers, dim);
+
+    // Window i belongs to speaker labels[i]; confidence is its cosine
+    // similarity to that speaker's centroid
+    for (size_t i = 0; i < labels.size(); ++i) {
+        DiarizationSegment seg;
+        seg.start = embeddings.starts[i];
+        seg.end = embeddings.ends[i];
+        seg.speaker_id = labels[i];
+        seg.speaker_label = "Speaker " + std::to_string(labels[i]);
+        seg.confidence = std::clamp(
+            EmbeddingOps::dot(matrix->row(i), centroids.data() + labels[i] * dim, dim), 0.0f, 1.0f);
+
+        segments.push_back(seg);
+    }
 
-        // Merge best pair if found
-        if (merged) {
-            // Merge cluster j into cluster i
-            clusters[best_i].insert(clusters[best_i].end(),
-                                   clusters[best_j].begin(), clusters[best_j].end());
+    return segments;
+}
 
-            // Update labels
-            int merged_label = best_i;
-            for (size_t idx : clusters[best_j]) {
-                cluster_labels[idx] = merged_label;
-            }
+// ═══════════════════════════════════════════════════════════
+// Online (Streaming) Diarization
+// ═══════════════════════════════════════════════════════════
 
-            // Remove cluster j
-            clusters.erase(clusters.begin() + best_j);
+std::vector<DiarizationSegment> Diarizer::push(const float* audio_data, size_t num_samples) {
+    if (!is_ready()) {
+        throw std::runtime_error("Diarizer not initialized");
+    }
 
-            // Renumber cluster labels
-            for (size_t i = 0; i < clusters.size(); ++i) {
-                for (size_t idx : clusters[i]) {
-                    cluster_labels[idx] = i;
-                }
-            }
+    constexpr int sample_rate = 16000;
+    std::vector<DiarizationSegment> settled;
+
+    // Pick up finished background re-clustering before assigning new windows
+    apply_recluster(false);
+
+    stream_buffer_.insert(stream_buffer_.end(), audio_data, audio_data + num_samples);
+
+    const size_t window_samples = static_cast<size_t>(options_.embedding_window_s * sample_rate);
+    size_t step_samples = static_cast<size_t>(options_.embedding_step_s * sample_rate);
+    if (window_samples == 0) {
+        return settled;
+    }
+    if (step_samples == 0) {
+        step_samples = window_samples;
+    }
+    const float step_s = static_cast<float>(step_samples) / sample_rate;
+
+    // Every full window in the buffer; silent ones are not sent to the model
+    std::vector<size_t> positions;
+    std::vector<char> voiced;
+    std::vector<size_t> offsets;
+    std::vector<float> starts;
+    std::vector<float> ends;
+
+    size_t pos = 0;
+    for (; pos + window_samples <= stream_buffer_.size(); pos += step_samples) {
+        const float* window = stream_buffer_.data() + pos;
+        float rms = std::sqrt(EmbeddingOps::dot(window, window, window_samples) / window_samples);
+        bool is_voiced = rms >= options_.online_silence_rms;
+
+        positions.push_back(pos);
+        voiced.push_back(is_voiced);
+        if (is_voiced) {
+            offsets.push_back(pos);
+            starts.push_back(static_cast<float>(stream_offset_ + pos) / sample_rate);
+            ends.push_back(static_cast<float>(stream_offset_ + pos + window_samples) / sample_rate);
         }
     }
 
-    // Apply max speakers limit
-    if (options_.max_speakers > 0 && static_cast<int>(clusters.size()) > options_.max_speakers) {
-        // Keep merging until we reach max_speakers
-        while (static_cast<int>(clusters.size()) > options_.max_speakers) {
-            float best_similarity = -1.0f;
-            size_t best_i = 0, best_j = 0;
-
-            // Find pair with highest similarity
-            for (size_t i = 0; i < clusters.size(); ++i) {
-                for (size_t j = i + 1; j < clusters.size(); ++j) {
-                    float total_similarity = 0.0f;
-                    size_t pair_count = 0;
-
-                    for (size_t idx_i : clusters[i]) {
-                        for (size_t idx_j : clusters[j]) {
-                            total_similarity += cosine_similarity(embeddings[idx_i], embeddings[idx_j]);
-                            pair_count++;
-                        }
-                    }
-
-                    float avg_similarity = total_similarity / pair_count;
-                    if (avg_similarity > best_similarity) {
-                        best_similarity = avg_similarity;
-                        best_i = i;
-                        best_j = j;
-                    }
-                }
-            }
+    if (positions.empty()) {
+        return settled;
+    }
 
-            // Merge best pair
-            clusters[best_i].insert(clusters[best_i].end(),
-                                   clusters[best_j].begin(), clusters[best_j].end());
-            clusters.erase(clusters.begin() + best_j);
+    EmbeddingMatrix embeddings;
+    if (!offsets.empty()) {
+        std::vector<size_t> lengths(offsets.size(), window_samples);
+        embeddings = embed_windows(stream_buffer_.data(), offsets, lengths, std::move(starts), std::move(ends));
+    }
 
-            // Renumber
-            for (size_t i = 0; i < clusters.size(); ++i) {
-                for (size_t idx : clusters[i]) {
-                    cluster_labels[idx] = i;
-                }
-            }
+    // Walk windows in time order; each contributes its first step as the "core"
+    size_t row = 0;
+    for (size_t w = 0; w < positions.size(); ++w) {
+        float core_start = static_cast<float>(stream_offset_ + positions[w]) / sample_rate;
+        float core_end = core_start + step_s;
+        stream_last_end_ = static_cast<float>(stream_offset_ + positions[w] + window_samples) / sample_rate;
+
+        if (!voiced[w]) {
+            close_stream_segment(settled);
+            continue;
         }
+
+        float confidence = 0.0f;
+        int slot = assign_stream_embedding(embeddings.row(row++), confidence);
+        speaker_durations_[slot] += step_s;
+        int speaker = speaker_ids_[slot];
+
+        if (stream_open_.speaker_id != speaker) {
+            close_stream_segment(settled);
+            stream_open_.speaker_id = speaker;
+            stream_open_.speaker_label = "Speaker " + std::to_string(speaker);
+            stream_open_.start = core_start;
+        }
+        stream_open_.end = core_end;
+        stream_open_confidence_ += confidence;
+        stream_open_windows_++;
     }
 
-    // Build Speaker objects
-    int max_speaker_id = *std::max_element(cluster_labels.begin(), cluster_labels.end());
+    // Keep only the samples the next window still needs
+    stream_buffer_.erase(stream_buffer_.begin(), stream_buffer_.begin() + pos);
+    stream_offset_ += pos;
+
+    if (options_.online_recluster_interval > 0 &&
+        embeddings_since_recluster_ >= static_cast<size_t>(options_.online_recluster_interval)) {
+        start_recluster();
+    }
 
-    for (int speaker_id = 0; speaker_id <= max_speaker_id; ++speaker_id) {
+    return settled;
+}
+
+std::vector<DiarizationSegment> Diarizer::flush() {
+    std::vector<DiarizationSegment> settled;
+    apply_recluster(true);
+
+    // The open segment extends to the end of the last analysed window
+    if (stream_open_.speaker_id >= 0) {
+        stream_open_.end = std::max(stream_open_.end, stream_last_end_);
+    }
+    close_stream_segment(settled);
+
+    stream_offset_ += stream_buffer_.size();
+    stream_buffer_.clear();
+    return settled;
+}
+
+void Diarizer::reset_stream() {
+    apply_recluster(true);
+
+    stream_buffer_.clear();
+    stream_offset_ = 0;
+    stream_last_end_ = 0.0f;
+    speaker_sums_.clear();
+    speaker_counts_.clear();
+    speaker_durations_.clear();
+    speaker_ids_.clear();
+    next_speaker_id_ = 0;
+    stream_open_ = DiarizationSegment();
+    stream_open_confidence_ = 0.0f;
+    stream_open_windows_ = 0;
+    embeddings_since_recluster_ = 0;
+    recluster_slots_.clear();
+}
+
+std::vector<Speaker> Diarizer::stream_speakers() const {
+    std::vector<Speaker> speakers;
+    for (size_t slot = 0; slot < speaker_counts_.size(); ++slot) {
+        if (speaker_counts_[slot] == 0.0) {
+            continue;  // Merged into another speaker
+        }
         Speaker speaker;
-        speaker.speaker_id = speaker_id;
-        speaker.label = "Speaker " + std::to_string(speaker_id);
-
-        // Collect embeddings for this speaker
-        for (size_t i = 0; i < embeddings.size(); ++i) {
-            if (cluster_labels[i] == speaker_id) {
-                speaker.embeddings.push_back(embeddings[i]);
-                speaker.total_duration += (embeddings[i].end - embeddings[i].start);
-            }
+        speaker.speaker_id = speaker_ids_[slot];
+        speaker.label = "Speaker " + std::to_string(speaker_ids_[slot]);
+        speaker.total_duration = speaker_durations_[slot];
+        speakers.push_back(speaker);
+    }
+    return speakers;
+}
+
+int Diarizer::assign_stream_embedding(const float* embedding, float& confidence) {
+    const size_t dim = backend_->dim();
+    const size_t slots = speaker_counts_.size();
+
+    // Average similarity to each speaker = dot(x, sum) / count (average linkage)
+    int best = -1;
+    float best_similarity = -std::numeric_limits<float>::infinity();
+    int active = 0;
+    size_t free_slot = slots;  // First slot emptied by a merge
+    for (size_t slot = 0; slot < slots; ++slot) {
+        if (speaker_counts_[slot] == 0.0) {
+            free_slot = std::min(free_slot, slot);
+            continue;
         }
+        active++;
+        float sim = EmbeddingOps::dot(embedding, speaker_sums_.data() + slot * dim, dim) /
+                    static_cast<float>(speaker_counts_[slot]);
+        if (sim > best_similarity) {
+            best_similarity = sim;
+            best = static_cast<int>(slot);
+        }
+    }
 
-        speakers.push_back(speaker);
+    bool at_limit = options_.max_speakers > 0 && active >= options_.max_speakers;
+    if (best < 0 || (best_similarity < options_.clustering_threshold && !at_limit)) {
+        // New speaker: reuse a merged-away slot (already zeroed) so the slot
+        // arrays stay bounded by the peak number of live speakers. The public
+        // ID always comes from the counter, so settled segments stay unambiguous.
+        best = static_cast<int>(free_slot);
+        if (free_slot == slots) {
+            speaker_sums_.resize((slots + 1) * dim, 0.0f);
+            speaker_counts_.push_back(0.0);
+            speaker_durations_.push_back(0.0f);
+            speaker_ids_.push_back(-1);
+        }
+        speaker_ids_[free_slot] = next_speaker_id_++;
+        best_similarity = 1.0f;
     }
 
-    // Sort by total duration (most active speaker first)
-    std::sort(speakers.begin(), speakers.end(),
-              [](const Speaker& a, const Speaker& b) {
-                  return a.total_duration > b.total_duration;
-              });
+    float* sum = speaker_sums_.data() + best * dim;
+    for (size_t d = 0; d < dim; ++d) {
+        sum[d] += embedding[d];
+    }
+    speaker_counts_[best] += 1.0;
+    embeddings_since_recluster_++;
 
-    // Reassign speaker IDs based on duration
-    for (size_t i = 0; i < speakers.size(); ++i) {
-        speakers[i].speaker_id = i;
-        speakers[i].label = "Speaker " + std::to_string(i);
+    confidence = std::clamp(best_similarity, 0.0f, 1.0f);
+    return best;
+}
+
+void Diarizer::close_stream_segment(std::vector<DiarizationSegment>& settled) {
+    if (stream_open_.speaker_id >= 0) {
+        stream_open_.confidence = stream_open_windows_ > 0
+            ? stream_open_confidence_ / stream_open_windows_ : 0.0f;
+        settled.push_back(stream_open_);
     }
+    stream_open_ = DiarizationSegment();
+    stream_open_confidence_ = 0.0f;
+    stream_open_windows_ = 0;
+}
 
-    return speakers;
+void Diarizer::start_recluster() {
+    if (recluster_future_.valid()) {
+        return;  // Previous run still in flight
+    }
+    embeddings_since_recluster_ = 0;
+
+    // Snapshot of active speaker means, weighted by embedding count
+    const size_t dim = backend_->dim();
+    std::vector<float> means;
+    std::vector<double> counts;
+    recluster_slots_.clear();
+    for (size_t slot = 0; slot < speaker_counts_.size(); ++slot) {
+        if (speaker_counts_[slot] == 0.0) {
+            continue;
+        }
+        recluster_slots_.push_back(slot);
+        counts.push_back(speaker_counts_[slot]);
+        const float* sum = speaker_sums_.data() + slot * dim;
+        for (size_t d = 0; d < dim; ++d) {
+            means.push_back(static_cast<float>(sum[d] / speaker_counts_[slot]));
+        }
+    }
+
+    if (counts.size() < 2) {
+        return;
+    }
+
+    const float threshold = options_.clustering_threshold;
+    const int max_speakers = options_.max_speakers;
+    recluster_future_ = std::async(std::launch::async,
+        [means = std::move(means), counts = std::move(counts), dim, threshold, max_speakers]() {
+            std::vector<float> similarity = condensed_similarity(means.data(), counts.size(), dim);
+            auto merges = average_linkage(similarity, counts);
+            return cut_dendrogram(merges, counts.size(), threshold, max_speakers);
+        });
 }
 
-std::vector<DiarizationSegment> Diarizer::embeddings_to_segments(
-    const std::vector<SpeakerEmbedding>& embeddings,
-    const std::vector<Speaker>& speakers) {
+void Diarizer::apply_recluster(bool wait) {
+    if (!recluster_future_.valid()) {
+        return;
+    }
+    if (!wait && recluster_future_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
 
-    std::vector<DiarizationSegment> segments;
+    std::vector<int> labels = recluster_future_.get();
+    const size_t dim = backend_->dim();
+
+    // First slot of each label survives; the others are folded into it
+    std::vector<int> keeper(labels.size(), -1);
+    for (size_t i = 0; i < labels.size(); ++i) {
+        size_t slot = recluster_slots_[i];
+        int& keep = keeper[labels[i]];
+        if (keep < 0) {
+            keep = static_cast<int>(slot);
+            continue;
+        }
 
-    for (const auto& emb : embeddings) {
-        // Find which speaker this embedding belongs to
-        int speaker_id = -1;
-        float max_similarity = -1.0f;
-
-        for (const auto& speaker : speakers) {
-            for (const auto& speaker_emb : speaker.embeddings) {
-                // Check if this embedding matches this speaker's embeddings
-                if (std::abs(emb.start - speaker_emb.start) < 0.01f &&
-                    std::abs(emb.end - speaker_emb.end) < 0.01f) {
-                    speaker_id = speaker.speaker_id;
-                    max_similarity = 1.0f;  // Perfect match
-                    break;
-                }
-            }
-            if (speaker_id >= 0) break;
+        float* dst = speaker_sums_.data() + keep * dim;
+        float* src = speaker_sums_.data() + slot * dim;
+        for (size_t d = 0; d < dim; ++d) {
+            dst[d] += src[d];
+            src[d] = 0.0f;
         }
+        speaker_counts_[keep] += speaker_counts_[slot];
+        speaker_durations_[keep] += speaker_durations_[slot];
+        speaker_counts_[slot] = 0.0;
+        speaker_durations_[slot] = 0.0f;
 
-        if (speaker_id >= 0) {
-            DiarizationSegment seg;
-            seg.start = emb.start;
-            seg.end = emb.end;
-            seg.speaker_id = speaker_id;
-            seg.speaker_label = "Speaker " + std::to_string(speaker_id);
-            seg.confidence = max_similarity;
+        int merged_id = speaker_ids_[slot];
+        int keep_id = speaker_ids_[keep];
+        speaker_ids_[slot] = -1;
+
+        std::cout << "[Diarizer] Online: merged Speaker " << merged_id << " into Speaker " << keep_id << "\n";
 
-            segments.push_back(seg);
+        if (stream_open_.speaker_id == merged_id) {
+            stream_open_.speaker_id = keep_id;
+            stream_open_.speaker_label = "Speaker " + std::to_string(keep_id);
         }
     }
 
-    return segments;
+    recluster_slots_.clear();
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -0,0 +1,261 @@
+#include "muninn/embedding_ops.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+namespace muninn {
+namespace EmbeddingOps {
+
+namespace {
+
+// Tile sizes: a 64 x 64 block of 512-d rows is 2 x 128KB, which stays in L2
+constexpr size_t kBlockRows = 64;
+
+// Micro-kernel tile: 2 rows of A against 4 rows of B (8 accumulators)
+constexpr size_t kTileA = 2;
+constexpr size_t kTileB = 4;
+
+#if defined(__AVX2__)
+
+constexpr size_t kLanes = 8;
+
+inline __m256 madd(__m256 a, __m256 b, __m256 acc) {
+#if defined(__FMA__) || defined(_MSC_VER)
+    return _mm256_fmadd_ps(a, b, acc);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), acc);
+#endif
+}
+
+inline float hsum(__m256 v) {
+    __m128 lo = _mm256_castps256_ps128(v);
+    __m128 hi = _mm256_extractf128_ps(v, 1);
+    lo = _mm_add_ps(lo, hi);
+    lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+    lo = _mm_add_ss(lo, _mm_shuffle_ps(lo, lo, 0x55));
+    return _mm_cvtss_f32(lo);
+}
+
+float dot_kernel(const float* a, const float* b, size_t dim) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t k = 0;
+    for (; k + 2 * kLanes <= dim; k += 2 * kLanes) {
+        acc0 = madd(_mm256_loadu_ps(a + k), _mm256_loadu_ps(b + k), acc0);
+        acc1 = madd(_mm256_loadu_ps(a + k + kLanes), _mm256_loadu_ps(b + k + kLanes), acc1);
+    }
+    for (; k + kLanes <= dim; k += kLanes) {
+        acc0 = madd(_mm256_loadu_ps(a + k), _mm256_loadu_ps(b + k), acc0);
+    }
+    float sum = hsum(_mm256_add_ps(acc0, acc1));
+    for (; k < dim; ++k) {
+        sum += a[k] * b[k];
+    }
+    return sum;
+}
+
+// out[r * ld + c] = dot(a[r], b[c]) for the 2 x 4 tile
+void tile_kernel(const float* const* a, const float* const* b, size_t dim, float* out, size_t ld) {
+    __m256 acc[kTileA][kTileB];
+    for (size_t r = 0; r < kTileA; ++r) {
+        for (size_t c = 0; c < kTileB; ++c) {
+            acc[r][c] = _mm256_setzero_ps();
+        }
+    }
+
+    size_t k = 0;
+    for (; k + kLanes <= dim; k += kLanes) {
+        __m256 va0 = _mm256_loadu_ps(a[0] + k);
+        __m256 va1 = _mm256_loadu_ps(a[1] + k);
+        for (size_t c = 0; c < kTileB; ++c) {
+            __m256 vb = _mm256_loadu_ps(b[c] + k);
+            acc[0][c] = madd(va0, vb, acc[0][c]);
+            acc[1][c] = madd(va1, vb, acc[1][c]);
+        }
+    }
+
+    for (size_t r = 0; r < kTileA; ++r) {
+        for (size_t c = 0; c < kTileB; ++c) {
+            float sum = hsum(acc[r][c]);
+            for (size_t t = k; t < dim; ++t) {
+                sum += a[r][t] * b[c][t];
+            }
+            out[r * ld + c] = sum;
+        }
+    }
+}
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+constexpr size_t kLanes = 4;
+
+float dot_kernel(const float* a, const float* b, size_t dim) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    size_t k = 0;
+    for (; k + 2 * kLanes <= dim; k += 2 * kLanes) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + k), vld1q_f32(b + k));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(a + k + kLanes), vld1q_f32(b + k + kLanes));
+    }
+    for (; k + kLanes <= dim; k += kLanes) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + k), vld1q_f32(b + k));
+    }
+    float sum = vaddvq_f32(vaddq_f32(acc0, acc1));
+    for (; k < dim; ++k) {
+        sum += a[k] * b[k];
+    }
+    return sum;
+}
+
+void tile_kernel(const float* const* a, const float* const* b, size_t dim, float* out, size_t ld) {
+    float32x4_t acc[kTileA][kTileB];
+    for (size_t r = 0; r < kTileA; ++r) {
+        for (size_t c = 0; c < kTileB; ++c) {
+            acc[r][c] = vdupq_n_f32(0.0f);
+        }
+    }
+
+    size_t k = 0;
+    for (; k + kLanes <= dim; k += kLanes) {
+        float32x4_t va0 = vld1q_f32(a[0] + k);
+        float32x4_t va1 = vld1q_f32(a[1] + k);
+        for (size_t c = 0; c < kTileB; ++c) {
+            float32x4_t vb = vld1q_f32(b[c] + k);
+            acc[0][c] = vfmaq_f32(acc[0][c], va0, vb);
+            acc[1][c] = vfmaq_f32(acc[1][c], va1, vb);
+        }
+    }
+
+    for (size_t r = 0; r < kTileA; ++r) {
+        for (size_t c = 0; c < kTileB; ++c) {
+            float sum = vaddvq_f32(acc[r][c]);
+            for (size_t t = k; t < dim; ++t) {
+                sum += a[r][t] * b[c][t];
+            }
+            out[r * ld + c] = sum;
+        }
+    }
+}
+
+#else
+
+float dot_kernel(const float* a, const float* b, size_t dim) {
+    float sum = 0.0f;
+    for (size_t k = 0; k < dim; ++k) {
+        sum += a[k] * b[k];
+    }
+    return sum;
+}
+
+void tile_kernel(const float* const* a, const float* const* b, size_t dim, float* out, size_t ld) {
+    float acc[kTileA][kTileB] = {};
+    for (size_t k = 0; k < dim; ++k) {
+        for (size_t r = 0; r < kTileA; ++r) {
+            for (size_t c = 0; c < kTileB; ++c) {
+                acc[r][c] += a[r][k] * b[c][k];
+            }
+        }
+    }
+    for (size_t r = 0; r < kTileA; ++r) {
+        for (size_t c = 0; c < kTileB; ++c) {
+            out[r * ld + c] = acc[r][c];
+        }
+    }
+}
+
+#endif
+
+// One kBlockRows x kBlockRows block: full tiles through the micro-kernel,
+// ragged edges through dot_kernel
+void block_kernel(const float* a, size_t rows_a, const float* b, size_t rows_b,
+                  size_t dim, float* out, size_t ld) {
+    size_t full_a = rows_a - rows_a % kTileA;
+    size_t full_b = rows_b - rows_b % kTileB;
+
+    const float* pa[kTileA];
+    const float* pb[kTileB];
+
+    for (size_t i = 0; i < full_a; i += kTileA) {
+        for (size_t r = 0; r < kTileA; ++r) {
+            pa[r] = a + (i + r) * dim;
+        }
+        for (size_t j = 0; j < full_b; j += kTileB) {
+            for (size_t c = 0; c < kTileB; ++c) {
+                pb[c] = b + (j + c) * dim;
+            }
+            tile_kernel(pa, pb, dim, out + i * ld + j, ld);
+        }
+        for (size_t j = full_b; j < rows_b; ++j) {
+            for (size_t r = 0; r < kTileA; ++r) {
+                out[(i + r) * ld + j] = dot_kernel(pa[r], b + j * dim, dim);
+            }
+        }
+    }
+
+    for (size_t i = full_a; i < rows_a; ++i) {
+        for (size_t j = 0; j < rows_b; ++j) {
+            out[i * ld + j] = dot_kernel(a + i * dim, b + j * dim, dim);
+        }
+    }
+}
+
+} // anonymous namespace
+
+float dot(const float* a, const float* b, size_t dim) {
+    return dot_kernel(a, b, dim);
+}
+
+float normalize(float* v, size_t dim) {
+    float norm = std::sqrt(dot_kernel(v, v, dim));
+    if (norm > 0.0f) {
+        float inv = 1.0f / norm;
+        for (size_t k = 0; k < dim; ++k) {
+            v[k] *= inv;
+        }
+    }
+    return norm;
+}
+
+void normalize_rows(float* data, size_t rows, size_t dim) {
+    for (size_t i = 0; i < rows; ++i) {
+        normalize(data + i * dim, dim);
+    }
+}
+
+void similarity_block(const float* a, size_t rows_a,
+                      const float* b, size_t rows_b,
+                      size_t dim, float* out, size_t ld_out) {
+    for (size_t i0 = 0; i0 < rows_a; i0 += kBlockRows) {
+        size_t bi = std::min(kBlockRows, rows_a - i0);
+        for (size_t j0 = 0; j0 < rows_b; j0 += kBlockRows) {
+            size_t bj = std::min(kBlockRows, rows_b - j0);
+            block_kernel(a + i0 * dim, bi, b + j0 * dim, bj, dim, out + i0 * ld_out + j0, ld_out);
+        }
+    }
+}
+
+void similarity_matrix(const float* data, size_t rows, size_t dim, float* out) {
+    for (size_t i0 = 0; i0 < rows; i0 += kBlockRows) {
+        size_t bi = std::min(kBlockRows, rows - i0);
+        for (size_t j0 = i0; j0 < rows; j0 += kBlockRows) {
+            size_t bj = std::min(kBlockRows, rows - j0);
+            block_kernel(data + i0 * dim, bi, data + j0 * dim, bj, dim, out + i0 * rows + j0, rows);
+
+            // Mirror into the lower triangle (also on the diagonal block, so
+            // the result is exactly symmetric)
+            for (size_t i = i0; i < i0 + bi; ++i) {
+                for (size_t j = std::max(j0, i + 1); j < j0 + bj; ++j) {
+                    out[j * rows + i] = out[i * rows + j];
+                }
+            }
+        }
+    }
+}
+
+} // namespace EmbeddingOps
+} // namespace muninn
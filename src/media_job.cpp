@@ -0,0 +1,140 @@
+#include "muninn/media_job.h"
+#include "muninn/translation_pipeline.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+namespace muninn {
+
+// ═══════════════════════════════════════════════════════════
+// Implementation
+// ═══════════════════════════════════════════════════════════
+
+class MediaJob::Impl {
+public:
+    MediaJobOptions options;
+    std::unique_ptr<Transcriber> transcriber;
+    std::unique_ptr<Translator> translator;
+
+    explicit Impl(const MediaJobOptions& opts)
+        : options(opts)
+    {
+        // CPU thread budget: NLLB gets its share, Whisper the rest. Whisper's
+        // device is only known after loading (CUDA may fall back to CPU), so
+        // the split is reserved up front and NLLB uses it whenever it runs on CPU
+        int budget = options.cpu_threads > 0 ? options.cpu_threads
+                                             : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        int translation_threads = 0;
+        ModelOptions whisper = options.whisper;
+        const bool translating = !options.translation_model_path.empty() && !options.target_langs.empty();
+
+        if (translating) {
+            float share = std::clamp(options.translation_thread_share, 0.0f, 1.0f);
+            translation_threads = std::clamp(static_cast<int>(std::lround(budget * share)), 1, std::max(1, budget - 1));
+            if (whisper.intra_threads == 0) {
+                whisper.intra_threads = std::max(1, budget - translation_threads);
+            }
+        }
+
+        transcriber = std::make_unique<Transcriber>(whisper);
+
+        if (!translating) {
+            return;
+        }
+
+        // Same device as Whisper (the resolved one, for DeviceType::Auto)
+        auto device = transcriber->get_device_info();
+        std::string compute_type = options.translation_compute_type;
+        if (compute_type.empty()) {
+            compute_type = device.is_cuda ? "float16" : "int8";
+        }
+
+        translator = std::make_unique<Translator>(options.translation_model_path, device.device, compute_type,
+                                                  device.device_index, device.is_cuda ? 0 : translation_threads);
+
+        std::cout << "[MediaJob] Whisper + NLLB on " << device.device;
+        if (device.is_cuda) {
+            std::cout << ":" << device.device_index;
+        } else {
+            std::cout << " (" << whisper.intra_threads << " + " << translation_threads << " threads)";
+        }
+        std::cout << "\n";
+    }
+};
+
+// ═══════════════════════════════════════════════════════════
+// MediaJob
+// ═══════════════════════════════════════════════════════════
+
+MediaJob::MediaJob(const MediaJobOptions& options)
+    : pimpl_(std::make_unique<Impl>(options))
+{
+}
+
+MediaJob::~MediaJob() = default;
+
+TranscribeResult MediaJob::run(const std::string& media_path,
+                               const TranscribeOptions& options,
+                               ProgressCallback progress_callback) {
+    Transcriber& transcriber = *pimpl_->transcriber;
+    if (!pimpl_->translator) {
+        return transcriber.transcribe(media_path, options, progress_callback);
+    }
+
+    Translator& translator = *pimpl_->translator;
+    translator.reset_cancel();
+
+    TranslationPipelineOptions pipeline_options;
+    pipeline_options.target_langs = pimpl_->options.target_langs;
+    pipeline_options.source_lang = options.language == "auto" ? "" : options.language;
+    pipeline_options.translation = pimpl_->options.translation;
+    pipeline_options.background_max_batch_size = pimpl_->options.background_max_batch_size;
+
+    TranslationPipeline pipeline(translator, pipeline_options);
+
+    // Translate each track while Whisper works on the next one
+    auto start = std::chrono::steady_clock::now();
+    pipeline.set_background(true);
+    transcriber.set_segment_callback(pipeline.segment_callback());
+
+    TranscribeResult result;
+    try {
+        result = transcriber.transcribe(media_path, options, progress_callback);
+    } catch (...) {
+        transcriber.set_segment_callback(nullptr);
+        throw;
+    }
+    transcriber.set_segment_callback(nullptr);
+
+    // Whisper is done: drain the remaining translations at full batch size
+    auto transcribed = std::chrono::steady_clock::now();
+    pipeline.set_background(false);
+    pipeline.finish(result);
+    auto finished = std::chrono::steady_clock::now();
+
+    std::cout << "[MediaJob] Transcription " << std::chrono::duration<double>(transcribed - start).count()
+              << "s, translation tail " << std::chrono::duration<double>(finished - transcribed).count()
+              << "s (" << pimpl_->options.target_langs.size() << " target(s))\n";
+
+    result.was_cancelled = result.was_cancelled || translator.is_cancelled();
+    return result;
+}
+
+void MediaJob::cancel() {
+    pimpl_->transcriber->cancel();
+    if (pimpl_->translator) {
+        pimpl_->translator->cancel();
+    }
+}
+
+Transcriber& MediaJob::transcriber() {
+    return *pimpl_->transcriber;
+}
+
+Translator* MediaJob::translator() {
+    return pimpl_->translator.get();
+}
+
+} // namespace muninn
@@ -1,4 +1,5 @@
 #include "muninn/mel_spectrogram.h"
+#include "muninn/speech_view.h"
 #include <algorithm>
 #include <cstring>
 
@@ -107,29 +108,36 @@ std::vector<std::vector<float>> MelSpectrogram::createMelFilters(int sample_rate
     return filters;
 }
 
-void MelSpectrogram::computeSTFT(const std::vector<float>& samples,
+void MelSpectrogram::computeSTFT(const SpeechView& samples,
                                  std::vector<std::vector<std::complex<float>>>& stft_output)
 {
+    if (samples.size() < static_cast<size_t>(n_fft_)) {
+        stft_output.clear();
+        return;
+    }
+
     int n_frames = (samples.size() - n_fft_) / hop_length_ + 1;
     int n_freqs = n_fft_ / 2 + 1;
 
     stft_output.resize(n_frames, std::vector<std::complex<float>>(n_freqs));
 
+    // Per-frame window read through the view (spans may cross a frame)
+    std::vector<float> frame_samples(n_fft_);
+
     // Simple DFT (not optimized FFT, but sufficient for proof-of-concept)
     // TODO: Replace with proper FFT library (e.g., FFTW, KissFFT) for production
     for (int frame = 0; frame < n_frames; frame++) {
-        int offset = frame * hop_length_;
+        size_t offset = static_cast<size_t>(frame) * hop_length_;
+        size_t available = samples.read(offset, frame_samples.data(), n_fft_);
 
         // Apply window and compute DFT
         for (int k = 0; k < n_freqs; k++) {
             std::complex<float> sum(0.0f, 0.0f);
 
-            for (int n = 0; n < n_fft_; n++) {
-                if (offset + n < static_cast<int>(samples.size())) {
-                    float windowed_sample = samples[offset + n] * hann_window_[n];
-                    float angle = -2.0f * M_PI * k * n / n_fft_;
-                    sum += windowed_sample * std::complex<float>(std::cos(angle), std::sin(angle));
-                }
+            for (int n = 0; n < static_cast<int>(available); n++) {
+                float windowed_sample = frame_samples[n] * hann_window_[n];
+                float angle = -2.0f * M_PI * k * n / n_fft_;
+                sum += windowed_sample * std::complex<float>(std::cos(angle), std::sin(angle));
             }
 
             stft_output[frame][k] = sum;
@@ -138,6 +146,11 @@ void MelSpectrogram::computeSTFT(const std::vector<float>& samples,
 }
 
 int MelSpectrogram::compute(const std::vector<float>& samples, std::vector<std::vector<float>>& mel_output)
+{
+    return compute(SpeechView(samples.data(), samples.size(), sample_rate_), mel_output);
+}
+
+int MelSpectrogram::compute(const SpeechView& samples, std::vector<std::vector<float>>& mel_output)
 {
     // Compute STFT
     std::vector<std::vector<std::complex<float>>> stft;
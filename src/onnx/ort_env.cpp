@@ -0,0 +1,17 @@
+#include "ort_env.h"
+
+#ifdef MUNINN_USE_SILERO_VAD
+
+namespace muninn {
+namespace onnx {
+
+Ort::Env& shared_env() {
+    // Function-local static: thread-safe initialisation, lives until exit
+    static Ort::Env env(ORT_LOGGING_LEVEL_WARNING, "Muninn");
+    return env;
+}
+
+} // namespace onnx
+} // namespace muninn
+
+#endif // MUNINN_USE_SILERO_VAD
@@ -0,0 +1,22 @@
+#pragma once
+
+#ifdef MUNINN_USE_SILERO_VAD
+
+#include <onnxruntime_cxx_api.h>
+
+namespace muninn {
+namespace onnx {
+
+/**
+ * Process-wide ONNX Runtime environment
+ *
+ * ONNX Runtime expects one Ort::Env per process; every session (Silero VAD,
+ * diarization embeddings, ...) is created against this one. Constructed on
+ * first use and safe to call from any thread.
+ */
+Ort::Env& shared_env();
+
+} // namespace onnx
+} // namespace muninn
+
+#endif // MUNINN_USE_SILERO_VAD
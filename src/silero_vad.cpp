@@ -1,4 +1,5 @@
 #include "muninn/silero_vad.h"
+#include "onnx/ort_env.h"
 #include <stdexcept>
 
 #ifdef MUNINN_USE_SILERO_VAD
@@ -6,7 +7,10 @@
 #include <onnxruntime_cxx_api.h>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <exception>
+#include <thread>
 
 namespace muninn {
 
@@ -14,7 +18,7 @@ class SileroVAD::Impl {
 public:
     Impl(const SileroVADOptions& options)
         : options_(options)
-        , env_(ORT_LOGGING_LEVEL_WARNING, "SileroVAD")
+        , env_(onnx::shared_env())
     {
         // Configure session options
         Ort::SessionOptions session_options;
@@ -67,25 +71,40 @@ public:
     bool is_ready() const { return ready_; }
 
     void reset_state() {
-        // Initialize state tensor (Silero VAD uses shape [2, 1, 128] = 256 floats)
-        state_.assign(2 * 1 * 128, 0.0f);
-        // Initialize context buffer (64 samples of previous audio)
-        context_.assign(context_size_, 0.0f);
+        stream_.reset();
         triggered_ = false;
         temp_end_ = 0;
         current_sample_ = 0;
     }
 
-    float predict(const std::vector<float>& chunk) {
+    // Recurrent model state for one sequential pass over audio
+    struct StreamState {
+        std::vector<float> state;      // LSTM state [2, 1, 128] = 256 floats
+        std::vector<float> context;    // Last 64 samples of previous window
+        std::vector<float> input;      // Scratch: context + window
+
+        StreamState() { reset(); }
+
+        void reset() {
+            state.assign(2 * 1 * 128, 0.0f);
+            context.assign(context_size_, 0.0f);
+        }
+    };
+
+    // Run one window through the model, advancing the given stream state.
+    // Ort::Session::Run is thread-safe, so shards may call this concurrently
+    // with their own StreamState.
+    float predict(const float* chunk, size_t chunk_size, StreamState& stream) {
         // Build augmented input: context (64 samples) + current chunk (512 samples) = 576 samples
-        std::vector<float> input_data;
-        input_data.reserve(context_size_ + chunk.size());
-        input_data.insert(input_data.end(), context_.begin(), context_.end());
-        input_data.insert(input_data.end(), chunk.begin(), chunk.end());
+        std::vector<float>& input_data = stream.input;
+        input_data.clear();
+        input_data.reserve(context_size_ + chunk_size);
+        input_data.insert(input_data.end(), stream.context.begin(), stream.context.end());
+        input_data.insert(input_data.end(), chunk, chunk + chunk_size);
 
         // Update context with last 64 samples from input for next iteration
         size_t context_start = input_data.size() - context_size_;
-        std::copy(input_data.begin() + context_start, input_data.end(), context_.begin());
+        std::copy(input_data.begin() + context_start, input_data.end(), stream.context.begin());
 
         // Prepare input tensor
         std::vector<int64_t> input_shape = {1, static_cast<int64_t>(input_data.size())};
@@ -104,7 +123,7 @@ public:
         // State tensor [2, 1, 128]
         std::vector<int64_t> state_shape = {2, 1, 128};
         input_tensors.push_back(Ort::Value::CreateTensor<float>(
-            memory_info, state_.data(), state_.size(),
+            memory_info, stream.state.data(), stream.state.size(),
             state_shape.data(), state_shape.size()));
 
         // Sample rate
@@ -130,11 +149,102 @@ public:
 
         // Update state for next iteration
         float* stateN_data = output_tensors[1].GetTensorMutableData<float>();
-        std::copy(stateN_data, stateN_data + state_.size(), state_.begin());
+        std::copy(stateN_data, stateN_data + stream.state.size(), stream.state.begin());
 
         return speech_prob;
     }
 
+    // Speech probability for windows [first, last) of samples, starting from a
+    // fresh state warmup_windows before first (warm-up outputs are discarded)
+    void predict_range(const std::vector<float>& samples,
+                       size_t first, size_t last, size_t warmup_windows,
+                       float* probs) {
+        size_t window_size = static_cast<size_t>(options_.window_size_samples);
+        size_t begin = first > warmup_windows ? first - warmup_windows : 0;
+
+        StreamState stream;
+        for (size_t w = begin; w < last; ++w) {
+            float prob = predict(samples.data() + w * window_size, window_size, stream);
+            if (w >= first) {
+                probs[w - first] = prob;
+            }
+        }
+    }
+
+    std::vector<float> speech_probabilities(const std::vector<float>& samples) {
+        size_t window_size = static_cast<size_t>(options_.window_size_samples);
+        size_t n_windows = samples.size() / window_size;
+        std::vector<float> probs(n_windows);
+
+        if (n_windows == 0) {
+            return probs;
+        }
+
+        // Shards shorter than this gain nothing over the warm-up cost
+        size_t warmup_windows = static_cast<size_t>(
+            std::ceil(options_.shard_warmup_s * options_.sample_rate / window_size));
+        size_t min_shard_windows = static_cast<size_t>(
+            options_.min_shard_duration_s * options_.sample_rate / window_size);
+        min_shard_windows = std::max<size_t>(min_shard_windows, 1);
+
+        size_t num_shards = static_cast<size_t>(std::max(1, options_.num_shards));
+        num_shards = std::min(num_shards, std::max<size_t>(1, n_windows / min_shard_windows));
+
+        if (num_shards <= 1 || using_gpu_) {
+            // Sequential: one recurrent pass over the whole track
+            for (size_t w = 0; w < n_windows; ++w) {
+                probs[w] = predict(samples.data() + w * window_size, window_size, stream_);
+            }
+            return probs;
+        }
+
+        // Shards are pulled from a shared counter by at most one worker per
+        // hardware thread (the caller included), however many shards there are
+        size_t hw_threads = std::max(1u, std::thread::hardware_concurrency());
+        size_t num_workers = std::min(num_shards, hw_threads);
+
+        std::cout << "[SileroVAD] Sharded VAD: " << num_shards << " shards on "
+                  << num_workers << " threads, " << options_.shard_warmup_s << "s warm-up\n";
+
+        // Shard boundaries are a pure function of (n_windows, num_shards), and
+        // each shard writes only its own slice, so the result does not depend
+        // on thread scheduling or on which worker runs which shard.
+        std::vector<std::exception_ptr> errors(num_shards);
+        std::atomic<size_t> next_shard{0};
+
+        auto run_shards = [&]() {
+            for (size_t shard = next_shard++; shard < num_shards; shard = next_shard++) {
+                size_t first = n_windows * shard / num_shards;
+                size_t last = n_windows * (shard + 1) / num_shards;
+                try {
+                    predict_range(samples, first, last, shard == 0 ? 0 : warmup_windows,
+                                  probs.data() + first);
+                } catch (...) {
+                    errors[shard] = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(num_workers - 1);
+        for (size_t i = 1; i < num_workers; ++i) {
+            workers.emplace_back(run_shards);
+        }
+        run_shards();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        return probs;
+    }
+
     std::vector<SpeechSegment> detect_speech(
         const std::vector<float>& samples,
         int sample_rate
@@ -152,6 +262,11 @@ public:
 
         reset_state();
 
+        // Model pass (sequential or sharded), then a single sequential segmentation
+        // pass. Segments spanning shard boundaries are stitched naturally because
+        // the state machine below sees one continuous probability stream.
+        std::vector<float> probs = speech_probabilities(samples);
+
         int window_size = options_.window_size_samples;
         float min_speech_sec = options_.min_speech_duration_ms / 1000.0f;
         float min_silence_sec = options_.min_silence_duration_ms / 1000.0f;
@@ -165,11 +280,10 @@ public:
         int max_speech_samples = static_cast<int>(max_speech_sec * sample_rate);
 
         // Process audio in chunks
-        for (size_t i = 0; i + window_size <= samples.size(); i += window_size) {
-            std::vector<float> chunk(samples.begin() + i, samples.begin() + i + window_size);
-            float speech_prob = predict(chunk);
+        for (size_t w = 0; w < probs.size(); ++w) {
+            float speech_prob = probs[w];
 
-            int current_pos = static_cast<int>(i);
+            int current_pos = static_cast<int>(w * window_size);
 
             if (speech_prob >= options_.threshold) {
                 // Speech detected
@@ -237,17 +351,16 @@ public:
 
 private:
     SileroVADOptions options_;
-    Ort::Env env_;
+    Ort::Env& env_;                      // Process-wide (onnx::shared_env)
     std::unique_ptr<Ort::Session> session_;
     bool ready_ = false;
     bool using_gpu_ = false;
 
-    // Model state tensor [2, 1, 128]
-    std::vector<float> state_;
-
-    // Context buffer for previous audio samples
+    // Context buffer size (samples of previous audio prepended to each window)
     static constexpr size_t context_size_ = 64;
-    std::vector<float> context_;
+
+    // Model state for sequential (unsharded) inference
+    StreamState stream_;
 
     // Detection state
     bool triggered_ = false;
@@ -285,7 +398,13 @@ std::vector<SpeechSegment> SileroVAD::detect_speech(
     return pimpl_->detect_speech(samples, sample_rate);
 }
 
-std::vector<float> SileroVAD::filter_silence(
+std::vector<float> SileroVAD::speech_probabilities(const std::vector<float>& samples) {
+    if (!pimpl_) return {};
+    pimpl_->reset_state();
+    return pimpl_->speech_probabilities(samples);
+}
+
+SpeechView SileroVAD::speech_view(
     const std::vector<float>& samples,
     int sample_rate,
     std::vector<SpeechSegment>& segments
@@ -307,25 +426,14 @@ std::vector<float> SileroVAD::filter_silence(
 
         std::cout << "[SileroVAD] No speech detected - returning original audio\n";
         silence_removed_ = 0.0f;
-        return samples;
+        return SpeechView(samples.data(), samples.size(), sample_rate);
     }
 
-    // Extract speech portions
-    std::vector<float> filtered;
+    // Reference speech portions in place (no copy)
     float total_duration = static_cast<float>(samples.size()) / sample_rate;
     float speech_duration = 0.0f;
 
     for (const auto& seg : segments) {
-        int start_sample = static_cast<int>(seg.start * sample_rate);
-        int end_sample = static_cast<int>(seg.end * sample_rate);
-
-        start_sample = std::max(0, start_sample);
-        end_sample = std::min(static_cast<int>(samples.size()), end_sample);
-
-        filtered.insert(filtered.end(),
-                       samples.begin() + start_sample,
-                       samples.begin() + end_sample);
-
         speech_duration += seg.end - seg.start;
     }
 
@@ -334,7 +442,15 @@ std::vector<float> SileroVAD::filter_silence(
     std::cout << "[SileroVAD] Removed " << silence_removed_ << "s silence ("
               << static_cast<int>(silence_removed_ / total_duration * 100) << "%)\n";
 
-    return filtered;
+    return SpeechView(samples.data(), samples.size(), segments, sample_rate);
+}
+
+std::vector<float> SileroVAD::filter_silence(
+    const std::vector<float>& samples,
+    int sample_rate,
+    std::vector<SpeechSegment>& segments
+) {
+    return speech_view(samples, sample_rate, segments).to_vector();
 }
 
 bool is_silero_vad_available() {
@@ -366,6 +482,16 @@ std::vector<SpeechSegment> SileroVAD::detect_speech(const std::vector<float>&, i
     return {};
 }
 
+std::vector<float> SileroVAD::speech_probabilities(const std::vector<float>&) {
+    return {};
+}
+
+SpeechView SileroVAD::speech_view(
+    const std::vector<float>& samples, int sample_rate, std::vector<SpeechSegment>&
+) {
+    return SpeechView(samples.data(), samples.size(), sample_rate);
+}
+
 std::vector<float> SileroVAD::filter_silence(
     const std::vector<float>& samples, int, std::vector<SpeechSegment>&
 ) {
@@ -0,0 +1,358 @@
+#include "muninn/speaker_profiles.h"
+#include "muninn/embedding_ops.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace muninn {
+
+namespace {
+
+constexpr char kMagic[4] = {'M', 'S', 'P', 'K'};
+constexpr uint32_t kVersion = 1;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t dim;
+    uint32_t count;
+};
+static_assert(sizeof(FileHeader) == 16, "Profile header must be 16 bytes");
+
+} // anonymous namespace
+
+// ═══════════════════════════════════════════════════════════
+// Implementation
+// ═══════════════════════════════════════════════════════════
+
+class SpeakerProfileStore::Impl {
+public:
+    size_t dim = 0;
+    size_t count = 0;
+    const char* names = nullptr;         // count * kNameBytes (mapped or owned)
+    const float* embeddings = nullptr;   // count * dim (mapped or owned)
+
+    // Owned storage once profiles are added/updated
+    std::vector<char> owned_names;
+    std::vector<float> owned_embeddings;
+
+    // Memory-mapped file
+    void* map_base = nullptr;
+    size_t map_size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+    ~Impl() { unmap(); }
+
+    bool map_file(const std::string& path, std::string& error) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            error = "Failed to open profile file: " + path;
+            return false;
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+            error = "Empty profile file: " + path;
+            unmap();
+            return false;
+        }
+        map_size = static_cast<size_t>(file_size.QuadPart);
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            error = "Failed to map profile file: " + path;
+            unmap();
+            return false;
+        }
+        map_base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (map_base == nullptr) {
+            error = "Failed to map profile file: " + path;
+            unmap();
+            return false;
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            error = "Failed to open profile file: " + path;
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            error = "Empty profile file: " + path;
+            ::close(fd);
+            return false;
+        }
+        map_size = static_cast<size_t>(st.st_size);
+        void* base = mmap(nullptr, map_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);  // The mapping keeps the file referenced
+        if (base == MAP_FAILED) {
+            error = "Failed to map profile file: " + path;
+            map_size = 0;
+            return false;
+        }
+        map_base = base;
+#endif
+        return true;
+    }
+
+    void unmap() {
+#ifdef _WIN32
+        if (map_base) UnmapViewOfFile(map_base);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (map_base) munmap(map_base, map_size);
+#endif
+        map_base = nullptr;
+        map_size = 0;
+    }
+
+    // Copy the mapped view into owned storage (before any modification)
+    void make_owned() {
+        if (map_base == nullptr) {
+            return;
+        }
+        owned_names.assign(names, names + count * kNameBytes);
+        owned_embeddings.assign(embeddings, embeddings + count * dim);
+        unmap();
+        repoint();
+    }
+
+    void repoint() {
+        names = owned_names.data();
+        embeddings = owned_embeddings.data();
+    }
+};
+
+// ═══════════════════════════════════════════════════════════
+// SpeakerProfileStore
+// ═══════════════════════════════════════════════════════════
+
+SpeakerProfileStore::SpeakerProfileStore()
+    : pimpl_(std::make_unique<Impl>())
+{
+}
+
+SpeakerProfileStore::~SpeakerProfileStore() = default;
+
+bool SpeakerProfileStore::load(const std::string& path) {
+    last_error_.clear();
+
+    auto impl = std::make_unique<Impl>();
+    if (!impl->map_file(path, last_error_)) {
+        std::cerr << "[SpeakerProfiles] " << last_error_ << "\n";
+        return false;
+    }
+
+    const char* base = static_cast<const char*>(impl->map_base);
+    FileHeader header;
+    if (impl->map_size < sizeof(header)) {
+        last_error_ = "Truncated profile file: " + path;
+        std::cerr << "[SpeakerProfiles] " << last_error_ << "\n";
+        return false;
+    }
+    std::memcpy(&header, base, sizeof(header));
+
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+        last_error_ = "Not a speaker profile file (or unsupported version): " + path;
+        std::cerr << "[SpeakerProfiles] " << last_error_ << "\n";
+        return false;
+    }
+
+    size_t names_bytes = static_cast<size_t>(header.count) * kNameBytes;
+    size_t embedding_bytes = static_cast<size_t>(header.count) * header.dim * sizeof(float);
+    if (impl->map_size < sizeof(header) + names_bytes + embedding_bytes) {
+        last_error_ = "Truncated profile file: " + path;
+        std::cerr << "[SpeakerProfiles] " << last_error_ << "\n";
+        return false;
+    }
+
+    // Header (16) + names (64 each) keeps the float block 16-byte aligned
+    impl->dim = header.dim;
+    impl->count = header.count;
+    impl->names = base + sizeof(header);
+    impl->embeddings = reinterpret_cast<const float*>(base + sizeof(header) + names_bytes);
+
+    pimpl_ = std::move(impl);
+
+    std::cout << "[SpeakerProfiles] Loaded " << pimpl_->count << " profile(s) from " << path << "\n";
+    return true;
+}
+
+bool SpeakerProfileStore::save(const std::string& path) {
+    last_error_.clear();
+
+    // Release the mapping first so the same file can be overwritten
+    pimpl_->make_owned();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        last_error_ = "Failed to write profile file: " + path;
+        std::cerr << "[SpeakerProfiles] " << last_error_ << "\n";
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.dim = static_cast<uint32_t>(pimpl_->dim);
+    header.count = static_cast<uint32_t>(pimpl_->count);
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(pimpl_->owned_names.data(), pimpl_->owned_names.size());
+    out.write(reinterpret_cast<const char*>(pimpl_->owned_embeddings.data()),
+              pimpl_->owned_embeddings.size() * sizeof(float));
+
+    if (!out) {
+        last_error_ = "Failed to write profile file: " + path;
+        std::cerr << "[SpeakerProfiles] " << last_error_ << "\n";
+        return false;
+    }
+    return true;
+}
+
+int SpeakerProfileStore::add_profile(const std::string& name, const float* embedding, size_t dim,
+                                     float new_weight) {
+    Impl& impl = *pimpl_;
+    if (impl.count > 0 && dim != impl.dim) {
+        throw std::runtime_error("Speaker profile dimension mismatch (store " + std::to_string(impl.dim) +
+                                 ", got " + std::to_string(dim) + ")");
+    }
+
+    impl.make_owned();
+    impl.dim = dim;
+
+    std::vector<float> normalized(embedding, embedding + dim);
+    EmbeddingOps::normalize(normalized.data(), dim);
+
+    int index = find(name);
+    if (index >= 0) {
+        // Blend with the existing centroid
+        float w = std::clamp(new_weight, 0.0f, 1.0f);
+        float* stored = impl.owned_embeddings.data() + index * dim;
+        for (size_t d = 0; d < dim; ++d) {
+            stored[d] = (1.0f - w) * stored[d] + w * normalized[d];
+        }
+        EmbeddingOps::normalize(stored, dim);
+        return index;
+    }
+
+    // New profile: NUL-padded, truncated name
+    std::vector<char> field(kNameBytes, '\0');
+    std::memcpy(field.data(), name.data(), std::min(name.size(), kNameBytes - 1));
+
+    impl.owned_names.insert(impl.owned_names.end(), field.begin(), field.end());
+    impl.owned_embeddings.insert(impl.owned_embeddings.end(), normalized.begin(), normalized.end());
+    impl.repoint();
+
+    return static_cast<int>(impl.count++);
+}
+
+std::vector<ProfileMatch> SpeakerProfileStore::search(const float* query, size_t k) const {
+    const Impl& impl = *pimpl_;
+    std::vector<ProfileMatch> matches;
+    if (impl.count == 0 || k == 0) {
+        return matches;
+    }
+
+    std::vector<float> scores(impl.count);
+    EmbeddingOps::similarity_block(query, 1, impl.embeddings, impl.count, impl.dim, scores.data(), impl.count);
+
+    k = std::min(k, impl.count);
+    std::vector<size_t> order(impl.count);
+    std::iota(order.begin(), order.end(), 0);
+    std::partial_sort(order.begin(), order.begin() + k, order.end(),
+                      [&scores](size_t a, size_t b) { return scores[a] > scores[b]; });
+
+    for (size_t i = 0; i < k; ++i) {
+        ProfileMatch match;
+        match.index = static_cast<int>(order[i]);
+        match.name = name(order[i]);
+        match.similarity = scores[order[i]];
+        matches.push_back(match);
+    }
+    return matches;
+}
+
+std::vector<ProfileMatch> SpeakerProfileStore::best_matches(const float* queries, size_t num_queries) const {
+    const Impl& impl = *pimpl_;
+    std::vector<ProfileMatch> matches(num_queries);
+    if (impl.count == 0) {
+        return matches;
+    }
+
+    // Chunked so the score block stays small for long query lists
+    constexpr size_t kChunk = 256;
+    std::vector<float> scores(std::min(kChunk, num_queries) * impl.count);
+
+    for (size_t first = 0; first < num_queries; first += kChunk) {
+        size_t rows = std::min(kChunk, num_queries - first);
+        EmbeddingOps::similarity_block(queries + first * impl.dim, rows, impl.embeddings, impl.count,
+                                       impl.dim, scores.data(), impl.count);
+
+        for (size_t r = 0; r < rows; ++r) {
+            const float* row = scores.data() + r * impl.count;
+            size_t best = static_cast<size_t>(std::max_element(row, row + impl.count) - row);
+            matches[first + r].index = static_cast<int>(best);
+            matches[first + r].similarity = row[best];
+        }
+    }
+
+    // Names only for the profiles actually hit
+    for (auto& match : matches) {
+        match.name = name(match.index);
+    }
+    return matches;
+}
+
+int SpeakerProfileStore::find(const std::string& name) const {
+    for (size_t i = 0; i < pimpl_->count; ++i) {
+        if (this->name(i) == name.substr(0, kNameBytes - 1)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+size_t SpeakerProfileStore::size() const {
+    return pimpl_->count;
+}
+
+size_t SpeakerProfileStore::dim() const {
+    return pimpl_->dim;
+}
+
+std::string SpeakerProfileStore::name(size_t index) const {
+    const char* field = pimpl_->names + index * kNameBytes;
+    return std::string(field, strnlen(field, kNameBytes));
+}
+
+const float* SpeakerProfileStore::embedding(size_t index) const {
+    return pimpl_->embeddings + index * pimpl_->dim;
+}
+
+} // namespace muninn
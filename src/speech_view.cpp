@@ -0,0 +1,202 @@
+#include "muninn/speech_view.h"
+#include "muninn/vad.h"
+#include <algorithm>
+#include <cstring>
+
+namespace muninn {
+
+SpeechView::SpeechView(const float* samples, size_t num_samples, int sample_rate)
+    : samples_(samples)
+    , sample_rate_(sample_rate)
+{
+    if (samples_ && num_samples > 0) {
+        spans_.push_back({0, num_samples});
+        offsets_ = {0, num_samples};
+    }
+}
+
+SpeechView::SpeechView(const float* samples, size_t num_samples,
+                       const std::vector<SpeechSegment>& segments,
+                       int sample_rate)
+    : samples_(samples)
+    , sample_rate_(sample_rate)
+{
+    if (!samples_ || num_samples == 0) {
+        return;
+    }
+
+    spans_.reserve(segments.size());
+    offsets_.reserve(segments.size() + 1);
+
+    size_t total = 0;
+    for (const auto& seg : segments) {
+        // Same clamping as the original filter_silence() concatenation
+        int start_sample = std::max(0, static_cast<int>(seg.start * sample_rate));
+        int end_sample = std::min(static_cast<int>(num_samples),
+                                  static_cast<int>(seg.end * sample_rate));
+
+        if (start_sample < end_sample) {
+            spans_.push_back({static_cast<size_t>(start_sample), static_cast<size_t>(end_sample)});
+            offsets_.push_back(total);
+            total += static_cast<size_t>(end_sample - start_sample);
+        }
+    }
+
+    if (!spans_.empty()) {
+        offsets_.push_back(total);
+    } else {
+        offsets_.clear();
+    }
+}
+
+size_t SpeechView::find_span(size_t pos) const {
+    // First span whose virtual start is > pos, minus one
+    auto it = std::upper_bound(offsets_.begin(), offsets_.end() - 1, pos);
+    return static_cast<size_t>(it - offsets_.begin()) - 1;
+}
+
+float SpeechView::operator[](size_t pos) const {
+    if (pos >= size()) {
+        return 0.0f;
+    }
+    size_t i = find_span(pos);
+    return samples_[spans_[i].begin + (pos - offsets_[i])];
+}
+
+size_t SpeechView::read(size_t pos, float* dst, size_t count) const {
+    size_t total = size();
+    if (pos >= total || count == 0) {
+        return 0;
+    }
+    count = std::min(count, total - pos);
+
+    size_t i = find_span(pos);
+    size_t copied = 0;
+    while (copied < count) {
+        size_t span_offset = pos + copied - offsets_[i];
+        size_t available = (offsets_[i + 1] - offsets_[i]) - span_offset;
+        size_t n = std::min(available, count - copied);
+        std::memcpy(dst + copied, samples_ + spans_[i].begin + span_offset, n * sizeof(float));
+        copied += n;
+        ++i;
+    }
+    return copied;
+}
+
+std::vector<float> SpeechView::to_vector() const {
+    std::vector<float> out(size());
+    if (!out.empty()) {
+        read(0, out.data(), out.size());
+    }
+    return out;
+}
+
+float SpeechView::to_original_time(float filtered_time) const {
+    if (spans_.empty()) {
+        return filtered_time;
+    }
+
+    double pos = static_cast<double>(filtered_time) * sample_rate_;
+    if (pos <= 0.0) {
+        return static_cast<float>(spans_.front().begin) / sample_rate_;
+    }
+    if (pos >= static_cast<double>(size())) {
+        return static_cast<float>(spans_.back().end) / sample_rate_;
+    }
+
+    // Span whose virtual range [offsets_[i], offsets_[i+1]] contains pos;
+    // a position exactly on a boundary belongs to the earlier span
+    auto it = std::lower_bound(offsets_.begin() + 1, offsets_.end(), pos,
+                               [](size_t offset, double p) { return static_cast<double>(offset) < p; });
+    size_t i = static_cast<size_t>(it - offsets_.begin()) - 1;
+
+    double original = static_cast<double>(spans_[i].begin) + (pos - static_cast<double>(offsets_[i]));
+    return static_cast<float>(original / sample_rate_);
+}
+
+void SpeechView::remap_to_original(std::vector<Segment>& segments) const {
+    if (spans_.empty() || segments.empty()) {
+        return;
+    }
+
+    // Gather every timestamp once, then sort so the offset table is walked a single time
+    std::vector<float*> times;
+    size_t total = 0;
+    for (const auto& seg : segments) {
+        total += 2 + 2 * seg.words.size();
+    }
+    times.reserve(total);
+
+    for (auto& seg : segments) {
+        times.push_back(&seg.start);
+        times.push_back(&seg.end);
+        for (auto& word : seg.words) {
+            times.push_back(&word.start);
+            times.push_back(&word.end);
+        }
+    }
+
+    // Whisper output is usually in order already; only sort when it is not
+    auto by_time = [](const float* a, const float* b) { return *a < *b; };
+    if (!std::is_sorted(times.begin(), times.end(), by_time)) {
+        std::sort(times.begin(), times.end(), by_time);
+    }
+
+    const double view_size = static_cast<double>(size());
+    const float first_start = static_cast<float>(spans_.front().begin) / sample_rate_;
+    const float last_end = static_cast<float>(spans_.back().end) / sample_rate_;
+
+    size_t i = 1;  // offsets_[i] = virtual end of span i-1
+    for (float* t : times) {
+        double pos = static_cast<double>(*t) * sample_rate_;
+
+        if (pos <= 0.0) {
+            *t = first_start;
+            continue;
+        }
+        if (pos >= view_size) {
+            *t = last_end;
+            continue;
+        }
+
+        // Same boundary rule as to_original_time(): first span whose end >= pos
+        while (static_cast<double>(offsets_[i]) < pos) {
+            ++i;
+        }
+
+        size_t span = i - 1;
+        double original = static_cast<double>(spans_[span].begin) + (pos - static_cast<double>(offsets_[span]));
+        *t = static_cast<float>(original / sample_rate_);
+    }
+}
+
+double SpeechView::speech_before(double pos) const {
+    // Last span starting at or before pos
+    auto it = std::upper_bound(spans_.begin(), spans_.end(), pos,
+                               [](double p, const Span& span) { return p < static_cast<double>(span.begin); });
+    if (it == spans_.begin()) {
+        return 0.0;
+    }
+
+    size_t i = static_cast<size_t>(it - spans_.begin()) - 1;
+    double covered = std::min(pos, static_cast<double>(spans_[i].end)) - static_cast<double>(spans_[i].begin);
+    return static_cast<double>(offsets_[i]) + covered;
+}
+
+float SpeechView::speech_overlap(float start, float end) const {
+    if (spans_.empty()) {
+        return 1.0f;  // No VAD info, assume all speech
+    }
+
+    if (end <= start) {
+        return 0.0f;
+    }
+
+    double a = static_cast<double>(start) * sample_rate_;
+    double b = static_cast<double>(end) * sample_rate_;
+    double overlap = speech_before(b) - speech_before(a);
+
+    return std::min(1.0f, static_cast<float>(overlap / (b - a)));
+}
+
+} // namespace muninn
@@ -2,9 +2,13 @@
 #include "muninn/logging.h"
 #include "muninn/mel_spectrogram.h"
 #include "muninn/audio_extractor.h"
+#include "muninn/audio_stats.h"
 #include "muninn/vad.h"
+#include "muninn/speech_view.h"
 #include "muninn/silero_vad.h"
+#include "muninn/webrtc_vad.h"
 #include "muninn/diarization.h"
+#include "ct2/model_registry.h"
 #include <ctranslate2/models/whisper.h>
 #include <ctranslate2/utils.h>
 #include <algorithm>
@@ -15,52 +19,15 @@
 #include <sstream>
 #include <stdexcept>
 #include <atomic>
+#include <chrono>
+#include <deque>
+#include <future>
 #include <unordered_map>
 #include <set>
 #ifdef WITH_CUDA
 #include <cuda_runtime.h>
 #endif
 
-namespace {
-
-/**
- * @brief Remap a timestamp from filtered audio back to original timeline
- *
- * When VAD removes silence, we concatenate speech segments. This function
- * maps a timestamp in the filtered audio back to the original audio timeline.
- *
- * @param filtered_time Timestamp in filtered (concatenated) audio
- * @param segments VAD speech segments with original timeline start/end
- * @return Timestamp in original audio timeline
- */
-float remap_timestamp_to_original(float filtered_time, const std::vector<muninn::SpeechSegment>& segments) {
-    if (segments.empty()) {
-        return filtered_time;  // No VAD applied
-    }
-
-    // Walk through segments to find which one contains this timestamp
-    float accumulated_duration = 0.0f;
-
-    for (const auto& seg : segments) {
-        float seg_duration = seg.end - seg.start;
-
-        if (filtered_time <= accumulated_duration + seg_duration) {
-            // This timestamp falls within this segment
-            float offset_in_segment = filtered_time - accumulated_duration;
-            return seg.start + offset_in_segment;
-        }
-
-        accumulated_duration += seg_duration;
-    }
-
-    // Past all segments - return end of last segment
-    if (!segments.empty()) {
-        return segments.back().end;
-    }
-    return filtered_time;
-}
-
-} // anonymous namespace
 #include <regex>
 #include <map>
 
@@ -72,7 +39,9 @@ namespace muninn {
 
 class Transcriber::Impl {
 public:
-    std::unique_ptr<ctranslate2::models::Whisper> model;
+    std::shared_ptr<ctranslate2::models::Whisper> model;  // Shared through ct2::acquire_whisper
+    ct2::LoadInfo load_info;              // Load time / whether weights were shared
+    SegmentCallback segment_callback;     // Optional per-track segment consumer
     MelSpectrogram mel_converter;
     bool model_loaded = false;
     std::string device_str;
@@ -183,7 +152,7 @@ public:
     }
 
     // Convert audio samples to mel-spectrogram
-    std::vector<std::vector<float>> compute_mel(const std::vector<float>& samples) {
+    std::vector<std::vector<float>> compute_mel(const SpeechView& samples) {
         std::vector<std::vector<float>> mel_features;
         int n_frames = mel_converter.compute(samples, mel_features);
 
@@ -212,6 +181,25 @@ public:
         const TranscribeOptions& options
     );
 
+    // Resolve the device (with CUDA -> CPU fallback) and acquire the model
+    void load_model(const std::string& model_path, const std::string& device,
+                    const std::string& compute_type, int gpu_index, int intra_threads);
+
+    // Registry key; intra_threads sizes the CPU replica (0 = CTranslate2 default)
+    static ct2::ModelKey model_key(const std::string& model_path, ctranslate2::Device device,
+                                   int gpu_index, int intra_threads) {
+        ct2::ModelKey key;
+        key.path = model_path;
+        key.device = device;
+        key.device_index = gpu_index;
+        key.intra_threads = static_cast<size_t>(std::max(0, intra_threads));
+        return key;
+    }
+
+    // Run synthetic windows through generate/detect_language/align (ModelOptions::warmup)
+    void warmup(int batch_size, int beam_size);
+    double warmup_time_ms = 0.0;
+
     // Extract text from CTranslate2 result, filtering special tokens
     std::string extract_text(const std::vector<std::string>& tokens);
 
@@ -1041,77 +1029,38 @@ bool needs_temperature_fallback(float compression_ratio, float avg_logprob, cons
            avg_logprob < options.log_prob_threshold;
 }
 
-/**
- * @brief Calculate how much of a segment overlaps with speech regions
- *
- * Returns a value between 0.0 (no overlap) and 1.0 (fully within speech regions)
- *
- * @param seg_start Segment start time (original timeline)
- * @param seg_end Segment end time (original timeline)
- * @param speech_segments VAD speech regions
- * @return Fraction of segment that overlaps with speech (0.0-1.0)
- */
-float calculate_speech_overlap(
-    float seg_start,
-    float seg_end,
-    const std::vector<SpeechSegment>& speech_segments
-) {
-    if (speech_segments.empty()) {
-        return 1.0f;  // No VAD info, assume all speech
-    }
-
-    float seg_duration = seg_end - seg_start;
-    if (seg_duration <= 0.0f) {
-        return 0.0f;
-    }
-
-    float overlap_duration = 0.0f;
-
-    for (const auto& speech : speech_segments) {
-        // Calculate overlap between segment and this speech region
-        float overlap_start = std::max(seg_start, speech.start);
-        float overlap_end = std::min(seg_end, speech.end);
-
-        if (overlap_end > overlap_start) {
-            overlap_duration += (overlap_end - overlap_start);
-        }
-    }
-
-    return std::min(1.0f, overlap_duration / seg_duration);
-}
-
 /**
  * @brief Filter segments that fall in silent regions (hallucination silence threshold)
  *
  * Based on faster-whisper's hallucination_silence_threshold parameter.
  * Removes segments where less than threshold fraction overlaps with speech regions.
+ * Overlap is an O(log n) lookup in the speech view's offset index.
  *
- * @param segments Segments to filter (modified in place)
- * @param speech_segments VAD speech regions
+ * @param segments Segments to filter (modified in place, original timeline)
+ * @param speech VAD speech view for the track
  * @param threshold Minimum speech overlap required (0.0 = disabled, 0.5 = 50% overlap required)
  */
 void filter_silence_hallucinations(
     std::vector<Segment>& segments,
-    const std::vector<SpeechSegment>& speech_segments,
+    const SpeechView& speech,
     float threshold
 ) {
-    if (threshold <= 0.0f || speech_segments.empty()) {
+    if (threshold <= 0.0f || speech.span_count() == 0) {
         return;  // Disabled or no VAD info
     }
 
-    auto it = segments.begin();
-    while (it != segments.end()) {
-        float overlap = calculate_speech_overlap(it->start, it->end, speech_segments);
+    auto new_end = std::remove_if(segments.begin(), segments.end(), [&](const Segment& seg) {
+        float overlap = speech.speech_overlap(seg.start, seg.end);
 
         if (overlap < threshold) {
             std::cerr << "[Muninn] Skipping silence hallucination: '"
-                      << it->text.substr(0, std::min(size_t(50), it->text.length()))
+                      << seg.text.substr(0, std::min(size_t(50), seg.text.length()))
                       << "' (speech overlap: " << (overlap * 100.0f) << "%)\n";
-            it = segments.erase(it);
-        } else {
-            ++it;
+            return true;
         }
-    }
+        return false;
+    });
+    segments.erase(new_end, segments.end());
 }
 
 std::vector<Segment> Transcriber::Impl::transcribe_chunk(
@@ -1712,16 +1661,93 @@ std::vector<std::vector<Segment>> Transcriber::Impl::transcribe_batch(
     return all_segments;
 }
 
-// =======================
-// Transcriber Public API
-// =======================
+void Transcriber::Impl::warmup(int batch_size, int beam_size) {
+    if (!model_loaded) {
+        return;
+    }
 
-Transcriber::Transcriber(
-    const std::string& model_path,
-    const std::string& device,
-    const std::string& compute_type
-) : pimpl_(std::make_unique<Impl>()) {
+    auto start = std::chrono::steady_clock::now();
+    const size_t batch = static_cast<size_t>(std::max(1, batch_size));
+    const size_t n_mels = model->n_mels();
+    const size_t n_frames = 3000;  // One full 30 s window
+
+    // Low-level noise rather than zeros, so nothing takes an all-silence shortcut
+    std::vector<float> flat(batch * n_mels * n_frames);
+    uint32_t state = 12345;
+    for (auto& value : flat) {
+        state = state * 1664525u + 1013904223u;
+        value = -0.5f + static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 0.1f;
+    }
+
+    try {
+        ctranslate2::StorageView features(
+            ctranslate2::Shape{static_cast<ctranslate2::dim_t>(batch),
+                               static_cast<ctranslate2::dim_t>(n_mels),
+                               static_cast<ctranslate2::dim_t>(n_frames)},
+            flat
+        );
+        std::vector<float> single(flat.begin(), flat.begin() + n_mels * n_frames);
+        ctranslate2::StorageView single_features(
+            ctranslate2::Shape{1, static_cast<ctranslate2::dim_t>(n_mels), static_cast<ctranslate2::dim_t>(n_frames)},
+            single
+        );
+
+        // Language detection (one window, as in transcribe_track)
+        if (model->is_multilingual()) {
+            for (auto& future : model->detect_language(single_features)) {
+                future.get();
+            }
+        }
+
+        // Decoding at the configured batch size and beam (same options as transcribe_batch)
+        std::vector<std::string> prompt = {"<|startoftranscript|>"};
+        if (model->is_multilingual()) {
+            prompt.push_back("<|en|>");
+        }
+        prompt.push_back("<|transcribe|>");
+        std::vector<std::vector<std::string>> prompts(batch, prompt);
+
+        ctranslate2::models::WhisperOptions whisper_options;
+        whisper_options.beam_size = static_cast<size_t>(std::max(1, beam_size));
+        whisper_options.patience = 1.0f;
+        whisper_options.length_penalty = 1.0f;
+        whisper_options.repetition_penalty = 1.0f;
+        whisper_options.no_repeat_ngram_size = 0;
+        whisper_options.max_length = 32;  // Enough steps to settle the decoder kernels
+        whisper_options.sampling_topk = 1;
+        whisper_options.sampling_temperature = 1.0f;
+        whisper_options.num_hypotheses = 1;
+        whisper_options.return_scores = true;
+        whisper_options.return_no_speech_prob = true;
+        whisper_options.max_initial_timestamp_index = 50;
+        whisper_options.suppress_blank = true;
+        whisper_options.suppress_tokens = {-1};
+
+        for (auto& future : model->generate(features, prompts, whisper_options)) {
+            future.get();
+        }
+
+        // Word alignment (cross-attention DTW) on a few ordinary text tokens
+        if (tokens_initialized) {
+            std::vector<size_t> text_tokens = {440, 1002, 1060, 2158};
+            for (auto& future : model->align(single_features, {sot_id}, {text_tokens}, {n_frames}, 7)) {
+                future.get();
+            }
+        }
+    } catch (const std::exception& e) {
+        Logger::warn("Warm-up failed (first transcription may be slower): " + std::string(e.what()));
+    }
+
+    warmup_time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    Logger::info("Warm-up: " + std::to_string(static_cast<int>(warmup_time_ms)) + " ms (batch " +
+                 std::to_string(batch) + ", beam " + std::to_string(std::max(1, beam_size)) + ")");
+}
 
+void Transcriber::Impl::load_model(const std::string& model_path,
+                                   const std::string& device,
+                                   const std::string& compute_type,
+                                   int gpu_index,
+                                   int intra_threads) {
     try {
         Logger::info("Loading Whisper model...");
 
@@ -1759,10 +1785,10 @@ Transcriber::Transcriber(
         int gpu_count = 0;
 
         cudaError_t cuda_err = cudaGetDeviceCount(&gpu_count);
-        if (cuda_err == cudaSuccess && gpu_count > 0) {
+        if (cuda_err == cudaSuccess && gpu_index >= 0 && gpu_index < gpu_count) {
             cuda_available = true;
             cudaDeviceProp prop;
-            if (cudaGetDeviceProperties(&prop, 0) == cudaSuccess) {
+            if (cudaGetDeviceProperties(&prop, gpu_index) == cudaSuccess) {
                 int compute_major = prop.major;
                 int compute_minor = prop.minor;
                 size_t vram_mb = prop.totalGlobalMem / (1024 * 1024);
@@ -1849,10 +1875,7 @@ Transcriber::Transcriber(
 
         if (cuda_was_requested) {
             try {
-                pimpl_->model = std::make_unique<ctranslate2::models::Whisper>(
-                    model_path,
-                    ct_device
-                );
+                model = ct2::acquire_whisper(model_key(model_path, ct_device, gpu_index, intra_threads), &load_info);
             } catch (const std::exception& cuda_error) {
                 // CUDA initialization failed - fall back to CPU
                 // Common reasons: compute capability too low, driver issues, AMD GPU, etc.
@@ -1863,17 +1886,11 @@ Transcriber::Transcriber(
                 cuda_fallback_to_cpu = true;
 
                 // Retry with CPU
-                pimpl_->model = std::make_unique<ctranslate2::models::Whisper>(
-                    model_path,
-                    ct_device
-                );
+                model = ct2::acquire_whisper(model_key(model_path, ct_device, 0, intra_threads), &load_info);
             }
         } else {
             // CPU was explicitly requested
-            pimpl_->model = std::make_unique<ctranslate2::models::Whisper>(
-                model_path,
-                ct_device
-            );
+            model = ct2::acquire_whisper(model_key(model_path, ct_device, 0, intra_threads), &load_info);
         }
 
         // Log if we had to fall back
@@ -1886,34 +1903,34 @@ Transcriber::Transcriber(
         }
 
         // Get model information
-        size_t num_languages = pimpl_->model->num_languages();
-        bool is_multilingual = pimpl_->model->is_multilingual();
-        size_t n_mels = pimpl_->model->n_mels();
+        size_t num_languages = model->num_languages();
+        bool is_multilingual = model->is_multilingual();
+        size_t n_mels = model->n_mels();
 
         Logger::info("Languages: " + std::string(is_multilingual ? "Multilingual" : "English-only") +
                     " (" + std::to_string(num_languages) + " languages)");
         Logger::info("Mel features: " + std::to_string(n_mels));
 
         // Reconfigure mel-spectrogram converter to match model's expected mel bins
-        if (n_mels != static_cast<size_t>(pimpl_->mel_converter.getMelBins())) {
-            Logger::info("Reconfiguring mel-spectrogram: " + std::to_string(pimpl_->mel_converter.getMelBins()) +
+        if (n_mels != static_cast<size_t>(mel_converter.getMelBins())) {
+            Logger::info("Reconfiguring mel-spectrogram: " + std::to_string(mel_converter.getMelBins()) +
                         " -> " + std::to_string(n_mels) + " mel bins");
-            pimpl_->mel_converter = MelSpectrogram(16000, 400, static_cast<int>(n_mels), 160);
+            mel_converter = MelSpectrogram(16000, 400, static_cast<int>(n_mels), 160);
         }
 
-        pimpl_->model_loaded = true;
-        pimpl_->device_str = device;
-        pimpl_->compute_type_str = compute_type;
+        model_loaded = true;
+        device_str = device;
+        compute_type_str = compute_type;
 
         // Determine actual device used
-        pimpl_->using_cuda = (ct_device == ctranslate2::Device::CUDA);
-        pimpl_->device_index = 0;
+        using_cuda = (ct_device == ctranslate2::Device::CUDA);
+        device_index = using_cuda ? gpu_index : 0;
 
         // Log device info
-        if (pimpl_->using_cuda) {
+        if (using_cuda) {
 #ifdef WITH_CUDA
             cudaDeviceProp prop;
-            if (cudaGetDeviceProperties(&prop, 0) == cudaSuccess) {
+            if (cudaGetDeviceProperties(&prop, gpu_index) == cudaSuccess) {
                 Logger::info("Device: CUDA - " + std::string(prop.name) + " (" + std::to_string(prop.totalGlobalMem / (1024*1024)) + " MB)");
             } else {
                 Logger::info("Device: CUDA (GPU details unavailable)");
@@ -1926,23 +1943,39 @@ Transcriber::Transcriber(
         }
 
         // Initialize token IDs for word-level alignment
-        pimpl_->initialize_token_ids();
+        initialize_token_ids();
 
         Logger::info("Model loaded successfully");
 
     } catch (const std::exception& e) {
         Logger::error("Failed to load Whisper model: " + std::string(e.what()));
-        pimpl_->model_loaded = false;
+        model_loaded = false;
         throw;
     }
 }
 
+// =======================
+// Transcriber Public API
+// =======================
+
+Transcriber::Transcriber(
+    const std::string& model_path,
+    const std::string& device,
+    const std::string& compute_type
+) : pimpl_(std::make_unique<Impl>()) {
+    pimpl_->load_model(model_path, device, compute_type, 0, 0);
+}
+
 // Constructor using ModelOptions struct
 Transcriber::Transcriber(const ModelOptions& options)
-    : Transcriber(options.model_path, options.device_string(), options.compute_type_string())
+    : pimpl_(std::make_unique<Impl>())
 {
-    // Additional configuration from ModelOptions can be applied here
-    // Threading options would be passed to CTranslate2 if supported
+    pimpl_->load_model(options.model_path, options.device_string(), options.compute_type_string(),
+                       options.device_index, options.intra_threads);
+
+    if (options.warmup) {
+        pimpl_->warmup(options.warmup_batch_size, options.warmup_beam_size);
+    }
 }
 
 Transcriber::~Transcriber() = default;
@@ -1979,6 +2012,25 @@ TranscribeResult Transcriber::transcribe(
     int track_id,
     int total_tracks,
     ProgressCallback progress_callback
+) {
+    // TODO: Resample if sample_rate != 16000
+    if (sample_rate != 16000) {
+        throw std::runtime_error("Only 16kHz audio is currently supported. Resampling not yet implemented.");
+    }
+
+    return transcribe_track(audio_samples, nullptr, options, track_id, total_tracks, progress_callback,
+                            nullptr, pimpl_->segment_callback);
+}
+
+TranscribeResult Transcriber::transcribe_track(
+    const std::vector<float>& audio_samples,
+    const AudioStatistics* stats,
+    const TranscribeOptions& options,
+    int track_id,
+    int total_tracks,
+    ProgressCallback progress_callback,
+    std::vector<SpeechSegment>* speech_out,
+    const SegmentCallback& segment_sink
 ) {
     TranscribeResult result;
     Logger::info("=== transcribe(samples) ENTERED: " + std::to_string(audio_samples.size()) + " samples ===");
@@ -2003,11 +2055,6 @@ TranscribeResult Transcriber::transcribe(
     };
 
     try {
-        // TODO: Resample if sample_rate != 16000
-        if (sample_rate != 16000) {
-            throw std::runtime_error("Only 16kHz audio is currently supported. Resampling not yet implemented.");
-        }
-
         float original_duration = audio_samples.size() / 16000.0f;
         std::cout << "[Muninn] Audio: " << audio_samples.size() << " samples, duration: "
                   << original_duration << "s\n";
@@ -2026,6 +2073,7 @@ TranscribeResult Transcriber::transcribe(
 
                 clipped_samples.assign(audio_samples.begin() + start_sample, audio_samples.begin() + end_sample);
                 clip_offset = clip_start;
+                stats = nullptr;  // Whole-track statistics no longer describe the clipped audio
 
                 std::cout << "[Muninn] Clipping audio: " << clip_start << "s - " << clip_end << "s ("
                           << clipped_samples.size() << " samples)\n";
@@ -2039,8 +2087,8 @@ TranscribeResult Transcriber::transcribe(
         // Update original_duration for clipped audio
         original_duration = clipped_samples.size() / 16000.0f;
 
-        // Apply VAD filtering based on selected type
-        std::vector<float> processed_samples;
+        // Apply VAD filtering based on selected type (view over clipped_samples, no copy)
+        SpeechView speech_view;
         std::vector<SpeechSegment> speech_segments;
 
         bool apply_vad = options.vad_filter && options.vad_type != VADType::None;
@@ -2052,7 +2100,8 @@ TranscribeResult Transcriber::transcribe(
             // Auto-detect VAD type if requested
             VADType effective_vad_type = options.vad_type;
             if (options.vad_type == VADType::Auto) {
-                effective_vad_type = auto_detect_vad_type(clipped_samples, track_id, total_tracks);
+                effective_vad_type = stats ? auto_detect_vad_type(*stats, track_id, total_tracks)
+                                           : auto_detect_vad_type(clipped_samples, track_id, total_tracks);
             }
 
             // Helper lambda for Energy VAD (used as fallback from Silero)
@@ -2066,10 +2115,10 @@ TranscribeResult Transcriber::transcribe(
                 vad_opts.speech_pad_ms = options.vad_speech_pad_ms;
 
                 VAD vad(vad_opts);
-                processed_samples = vad.filter_silence(clipped_samples, 16000, speech_segments);
+                speech_view = vad.speech_view(clipped_samples, 16000, speech_segments);
 
                 std::cout << "[Muninn] Energy VAD: " << speech_segments.size() << " speech segments, "
-                          << (processed_samples.size() / 16000.0f) << "s of speech\n";
+                          << speech_view.duration() << "s of speech\n";
             };
 
             // Flag to track if we need energy VAD fallback
@@ -2105,11 +2154,12 @@ TranscribeResult Transcriber::transcribe(
                         silero_opts.min_silence_duration_ms = options.vad_min_silence_duration_ms > 200 ? 100 : options.vad_min_silence_duration_ms;
                         silero_opts.speech_pad_ms = options.vad_speech_pad_ms;
                         silero_opts.max_speech_duration_s = options.vad_max_speech_duration_s;
+                        silero_opts.num_shards = options.silero_num_shards;
 
                         SileroVAD silero(silero_opts);
-                        processed_samples = silero.filter_silence(clipped_samples, 16000, speech_segments);
+                        speech_view = silero.speech_view(clipped_samples, 16000, speech_segments);
 
-                        if (processed_samples.empty()) {
+                        if (speech_view.empty()) {
                             Logger::warn("No speech detected (Silero VAD) - returning empty result");
                             result.duration = original_duration;
                             result.language = options.language;
@@ -2117,7 +2167,7 @@ TranscribeResult Transcriber::transcribe(
                         }
 
                         std::cout << "[Muninn] Silero VAD: " << speech_segments.size() << " speech segments, "
-                                  << (processed_samples.size() / 16000.0f) << "s of speech\n";
+                                  << speech_view.duration() << "s of speech\n";
                     } catch (const std::exception& e) {
                         std::cerr << "[Muninn] Silero VAD failed: " << e.what() << ", falling back to Energy VAD\n";
                         use_energy_vad = true;
@@ -2125,10 +2175,30 @@ TranscribeResult Transcriber::transcribe(
                     break;
                 }
 
-                case VADType::WebRTC:
-                    std::cerr << "[Muninn] WebRTC VAD not yet implemented, falling back to Energy VAD\n";
-                    use_energy_vad = true;
+                case VADType::WebRTC: {
+                    std::cout << "[Muninn] Applying WebRTC VAD filter...\n";
+
+                    WebRTCVADOptions webrtc_opts;
+                    webrtc_opts.frame_duration_ms = options.webrtc_frame_duration_ms;
+                    webrtc_opts.aggressiveness = options.webrtc_aggressiveness;
+                    webrtc_opts.min_speech_duration_ms = options.vad_min_speech_duration_ms;
+                    webrtc_opts.min_silence_duration_ms = options.vad_min_silence_duration_ms;
+                    webrtc_opts.speech_pad_ms = options.vad_speech_pad_ms;
+
+                    WebRTCVAD webrtc(webrtc_opts);
+                    speech_view = webrtc.speech_view(clipped_samples, 16000, speech_segments);
+
+                    if (speech_view.empty()) {
+                        Logger::warn("No speech detected (WebRTC VAD) - returning empty result");
+                        result.duration = original_duration;
+                        result.language = options.language;
+                        return result;
+                    }
+
+                    std::cout << "[Muninn] WebRTC VAD: " << speech_segments.size() << " speech segments, "
+                              << speech_view.duration() << "s of speech\n";
                     break;
+                }
 
                 case VADType::Energy:
                     use_energy_vad = true;
@@ -2136,14 +2206,14 @@ TranscribeResult Transcriber::transcribe(
 
                 case VADType::None:
                 default:
-                    processed_samples = clipped_samples;
+                    speech_view = SpeechView(clipped_samples.data(), clipped_samples.size(), 16000);
                     break;
             }
 
             // Apply energy VAD if needed (fallback or direct selection)
             if (use_energy_vad) {
                 apply_energy_vad();
-                if (processed_samples.empty()) {
+                if (speech_view.empty()) {
                     Logger::warn("No speech detected (Energy VAD) - returning empty result");
                     result.duration = original_duration;
                     result.language = options.language;
@@ -2151,13 +2221,22 @@ TranscribeResult Transcriber::transcribe(
                 }
             }
         } else {
-            processed_samples = clipped_samples;
-            Logger::info("VAD disabled, using all " + std::to_string(processed_samples.size()) + " samples");
+            speech_view = SpeechView(clipped_samples.data(), clipped_samples.size(), 16000);
+            Logger::info("VAD disabled, using all " + std::to_string(speech_view.size()) + " samples");
+        }
+
+        // Hand the speech timeline to the caller (e.g. diarization), in track time
+        if (speech_out) {
+            *speech_out = speech_segments;
+            for (auto& seg : *speech_out) {
+                seg.start += clip_offset;
+                seg.end += clip_offset;
+            }
         }
 
         // Convert to mel-spectrogram
-        Logger::info("Converting to mel-spectrogram from " + std::to_string(processed_samples.size()) + " samples");
-        auto mel_features = pimpl_->compute_mel(processed_samples);
+        Logger::info("Converting to mel-spectrogram from " + std::to_string(speech_view.size()) + " samples");
+        auto mel_features = pimpl_->compute_mel(speech_view);
 
         int n_frames = mel_features.size();
         Logger::info("Mel-spectrogram: " + std::to_string(n_frames) + " frames x " +
@@ -2196,6 +2275,41 @@ TranscribeResult Transcriber::transcribe(
             result.language_probability = 1.0f;
         }
 
+        // Bring new segments onto the track timeline and hand them to the sink. Runs
+        // once per batch of 30s chunks, so consumers start before the track ends.
+        if (clip_offset > 0.0f) {
+            std::cout << "[Muninn] Adjusting timestamps by clip offset: +" << clip_offset << "s\n";
+        }
+        auto finish_segments = [&](std::vector<Segment>& segments) {
+            // Remap timestamps from filtered audio back to original timeline if VAD was applied
+            if (!speech_segments.empty()) {
+                speech_view.remap_to_original(segments);  // Includes word timestamps
+
+                // Filter segments in silent regions (hallucination silence threshold)
+                filter_silence_hallucinations(segments, speech_view,
+                                              options.hallucination_silence_threshold);
+            }
+
+            // Per-segment track and language enable per-track translation of multi-track files
+            for (auto& seg : segments) {
+                seg.start += clip_offset;
+                seg.end += clip_offset;
+                for (auto& word : seg.words) {
+                    word.start += clip_offset;
+                    word.end += clip_offset;
+                }
+                seg.track_id = track_id;
+                if (seg.language.empty() && !result.language.empty()) {
+                    seg.language = result.language;
+                    seg.language_probability = result.language_probability;
+                }
+            }
+
+            if (segment_sink && !segments.empty()) {
+                segment_sink(segments);
+            }
+        };
+
         // Track repeated segments across chunks to detect hallucinations like "Thank you" repeated
         std::map<std::string, int> segment_text_counts;
 
@@ -2263,6 +2377,7 @@ TranscribeResult Transcriber::transcribe(
                 auto batch_results = pimpl_->transcribe_batch(batch_features, batch_start_times, effective_options);
 
                 // Process results and filter hallucinations
+                std::vector<Segment> batch_segments;
                 for (int i = 0; i < current_batch_size; ++i) {
                     for (auto& seg : batch_results[i]) {
                         std::string normalized = seg.text;
@@ -2276,10 +2391,14 @@ TranscribeResult Transcriber::transcribe(
                             continue;
                         }
 
-                        result.segments.push_back(seg);
+                        batch_segments.push_back(seg);
                     }
                 }
 
+                // This batch's segments are final: emit them while the next batch decodes
+                finish_segments(batch_segments);
+                result.segments.insert(result.segments.end(), batch_segments.begin(), batch_segments.end());
+
                 // Report progress AFTER batch completes (scales from 10% to 90%)
                 // batch_num/total_batches gives 0.x to 1.0, scale to 10%-90% range
                 if (progress_callback) {
@@ -2304,27 +2423,6 @@ TranscribeResult Transcriber::transcribe(
             std::cout << "[Muninn] Completed batched transcription: " << result.segments.size() << " total segments\n";
             std::cout.flush();
 
-            // Remap timestamps from filtered audio back to original timeline if VAD was applied
-            if (!speech_segments.empty()) {
-                std::cout << "[Muninn] Remapping timestamps to original timeline...\n";
-                std::cout.flush();
-                for (auto& seg : result.segments) {
-                    float orig_start = remap_timestamp_to_original(seg.start, speech_segments);
-                    float orig_end = remap_timestamp_to_original(seg.end, speech_segments);
-                    seg.start = orig_start;
-                    seg.end = orig_end;
-                    // Also remap word timestamps to original timeline
-                    for (auto& word : seg.words) {
-                        word.start = remap_timestamp_to_original(word.start, speech_segments);
-                        word.end = remap_timestamp_to_original(word.end, speech_segments);
-                    }
-                }
-
-                // Filter segments in silent regions (hallucination silence threshold)
-                filter_silence_hallucinations(result.segments, speech_segments,
-                                              options.hallucination_silence_threshold);
-            }
-
         } else {
             // Single chunk processing (audio <= 30 seconds)
             std::cout << "[Muninn] Audio short enough for single-pass transcription\n";
@@ -2343,39 +2441,7 @@ TranscribeResult Transcriber::transcribe(
                 progress_callback(track_id, total_tracks, 0.90f, "Transcription complete");
             }
 
-            // Remap timestamps from filtered audio back to original timeline if VAD was applied
-            if (!speech_segments.empty()) {
-                std::cout << "[Muninn] Remapping timestamps to original timeline...\n";
-                for (auto& seg : result.segments) {
-                    float orig_start = remap_timestamp_to_original(seg.start, speech_segments);
-                    float orig_end = remap_timestamp_to_original(seg.end, speech_segments);
-                    seg.start = orig_start;
-                    seg.end = orig_end;
-                    // Also remap word timestamps to original timeline
-                    for (auto& word : seg.words) {
-                        word.start = remap_timestamp_to_original(word.start, speech_segments);
-                        word.end = remap_timestamp_to_original(word.end, speech_segments);
-                    }
-                }
-
-                // Filter segments in silent regions (hallucination silence threshold)
-                filter_silence_hallucinations(result.segments, speech_segments,
-                                              options.hallucination_silence_threshold);
-            }
-        }
-
-        // Add clip_offset to all segment timestamps to reflect original timeline
-        if (clip_offset > 0.0f) {
-            std::cout << "[Muninn] Adjusting timestamps by clip offset: +" << clip_offset << "s\n";
-            for (auto& seg : result.segments) {
-                seg.start += clip_offset;
-                seg.end += clip_offset;
-                // Also adjust word timestamps if present
-                for (auto& word : seg.words) {
-                    word.start += clip_offset;
-                    word.end += clip_offset;
-                }
-            }
+            finish_segments(result.segments);
         }
 
         // Language is already set above during language detection or from options
@@ -2415,6 +2481,71 @@ TranscribeResult Transcriber::transcribe(
     combined_result.language = options.language;
     combined_result.language_probability = 1.0f;
 
+    // Speaker diarization runs per track on the samples and VAD timeline
+    // already in memory (no second decode)
+    std::unique_ptr<Diarizer> diarizer;
+    if (options.enable_diarization && !options.diarization_model_path.empty()) {
+        try {
+            DiarizationOptions diar_opts;
+            diar_opts.embedding_model_path = options.diarization_model_path;
+            diar_opts.clustering_threshold = options.diarization_threshold;
+            diar_opts.min_speakers = options.diarization_min_speakers;
+            diar_opts.max_speakers = options.diarization_max_speakers;
+            diar_opts.speaker_profiles_path = options.diarization_profiles_path;
+            diar_opts.num_sessions = std::max(1, options.diarization_parallel_tracks);
+
+            diarizer = std::make_unique<Diarizer>(options.diarization_model_path, diar_opts);
+        } catch (const std::exception& e) {
+            std::cerr << "[Muninn] Warning: Diarization failed: " << e.what() << "\n";
+            std::cerr << "[Muninn] Continuing without speaker labels...\n";
+        }
+    }
+
+    // Tracks are diarized in the background while Whisper moves on to the
+    // next track; results are applied to the merged segments by track_id.
+    // At most diarization_parallel_tracks run at once (each holds its samples).
+    struct PendingDiarization {
+        int track;
+        std::future<DiarizationResult> result;
+    };
+    std::deque<PendingDiarization> pending_diarization;
+    const size_t max_parallel_diarization = static_cast<size_t>(std::max(1, options.diarization_parallel_tracks));
+
+    // Without diarization, transcribe_track streams each batch of chunks to the
+    // segment callback. With it, a track's segments are held back until its
+    // speakers are assigned and then handed over together.
+    auto emit_track_segments = [this, &combined_result](int track) {
+        if (!pimpl_->segment_callback) {
+            return;
+        }
+        std::vector<Segment> track_segments;
+        for (const auto& segment : combined_result.segments) {
+            if (segment.track_id == track) {
+                track_segments.push_back(segment);
+            }
+        }
+        if (!track_segments.empty()) {
+            pimpl_->segment_callback(track_segments);
+        }
+    };
+
+    auto finish_diarization = [&combined_result, &options, &emit_track_segments](PendingDiarization& job) {
+        try {
+            DiarizationResult diar_result = job.result.get();
+            std::cout << "[Diarization] Track " << job.track << ": Detected "
+                      << diar_result.num_speakers << " speaker(s)\n";
+
+            // Largest-overlap speaker per segment and word of this track
+            Diarizer::assign_speakers_to_segments(combined_result.segments, diar_result, job.track);
+            if (options.diarization_split_segments) {
+                Diarizer::split_segments_by_speaker(combined_result.segments, diar_result, job.track);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "[Diarization] WARNING: Track " << job.track << " failed: " << e.what() << "\n";
+        }
+        emit_track_segments(job.track);
+    };
+
     // Process each track
     for (int track = 0; track < track_count; ++track) {
         // Check if track should be skipped (user-specified)
@@ -2451,7 +2582,8 @@ TranscribeResult Transcriber::transcribe(
         }
 
         std::vector<float> samples;
-        if (!extractor.extract_track(track, samples)) {
+        AudioStatistics track_stats;
+        if (!extractor.extract_track(track, samples, track_stats)) {
             Logger::warn("Failed to extract track " + std::to_string(track) + ": " + extractor.get_last_error());
             continue;
         }
@@ -2459,6 +2591,17 @@ TranscribeResult Transcriber::transcribe(
         Logger::info("Track " + std::to_string(track) + ": " + std::to_string(samples.size()) + " samples (" +
                      std::to_string(samples.size() / 16000.0f) + "s)");
 
+        // Track-level decisions from decode-time statistics (no extra pass over samples)
+        if (options.skip_silent_tracks && track_stats.is_silent()) {
+            std::cout << "[Muninn] Track " << track << " is silent (peak: " << track_stats.peak << ") - skipping\n";
+            continue;
+        }
+
+        if (options.skip_music_tracks && analyze_audio_characteristics(track_stats).is_music_like) {
+            std::cout << "[Muninn] Track " << track << " looks like continuous music - skipping\n";
+            continue;
+        }
+
         // Report progress - Audio extracted (5%)
         if (progress_callback) {
             progress_callback(track, track_count, 0.05f, "Audio extracted, preparing transcription...");
@@ -2469,7 +2612,10 @@ TranscribeResult Transcriber::transcribe(
                      std::to_string(samples.size()) + " samples, vad_filter=" +
                      std::string(options.vad_filter ? "ON" : "OFF"));
         try {
-            auto track_result = transcribe(samples, 16000, options, track, track_count, progress_callback);
+            std::vector<SpeechSegment> speech_segments;
+            auto track_result = transcribe_track(samples, &track_stats, options, track, track_count,
+                                                 progress_callback, &speech_segments,
+                                                 diarizer ? nullptr : pimpl_->segment_callback);
             Logger::info("transcribe() returned " + std::to_string(track_result.segments.size()) + " segments");
 
             // Report progress - Transcription complete, processing results (95%)
@@ -2477,15 +2623,33 @@ TranscribeResult Transcriber::transcribe(
                 progress_callback(track, track_count, 0.95f, "Processing results for track " + std::to_string(track + 1));
             }
 
-            // Set track_id and per-track language for each segment
-            // This enables proper per-track language handling in multi-language multi-track files
-            for (auto& segment : track_result.segments) {
-                segment.track_id = track;
-                // Copy tracks detected language to each segment for per-track translation
-                if (segment.language.empty() && !track_result.language.empty()) {
-                    segment.language = track_result.language;
-                    segment.language_probability = track_result.language_probability;
+            // Segments already carry track_id and the track's detected language
+            // (set in transcribe_track), for per-track translation of multi-track files
+
+            // Speaker diarization for this track (embeddings inside speech only),
+            // in the background so it overlaps transcription of the next track
+            bool diarization_queued = false;
+            if (diarizer && !track_result.segments.empty() && !track_result.was_cancelled) {
+                if (pending_diarization.size() >= max_parallel_diarization) {
+                    finish_diarization(pending_diarization.front());
+                    pending_diarization.pop_front();
                 }
+
+                std::cout << "[Diarization] Processing Track " << track << "...\n";
+
+                // The task owns the track's samples and speech timeline
+                auto track_samples = std::make_shared<std::vector<float>>(std::move(samples));
+                auto track_speech = std::make_shared<std::vector<SpeechSegment>>(std::move(speech_segments));
+                Diarizer* track_diarizer = diarizer.get();
+
+                pending_diarization.push_back({track, std::async(std::launch::async,
+                    [track_diarizer, track_samples, track_speech]() {
+                        return track_speech->empty()
+                            ? track_diarizer->diarize(track_samples->data(), track_samples->size(), 16000)
+                            : track_diarizer->diarize(track_samples->data(), track_samples->size(),
+                                                      *track_speech, 16000);
+                    })});
+                diarization_queued = true;
             }
 
             // Merge into combined result BEFORE checking cancellation
@@ -2493,6 +2657,12 @@ TranscribeResult Transcriber::transcribe(
             combined_result.segments.insert(combined_result.segments.end(),
                 track_result.segments.begin(), track_result.segments.end());
 
+            // With diarization enabled, segments are final once speakers are assigned;
+            // a track that was not queued (cancelled or empty) is handed over now
+            if (diarizer && !diarization_queued) {
+                emit_track_segments(track);
+            }
+
             // Check if inner transcription was cancelled AFTER merging segments
             // This way any completed work is preserved
             if (track_result.was_cancelled) {
@@ -2537,87 +2707,13 @@ TranscribeResult Transcriber::transcribe(
     Logger::info("All tracks complete. Total segments: " + std::to_string(combined_result.segments.size()));
     std::cout.flush();
 
-    // ═══════════════════════════════════════════════════════════
-    // Speaker Diarization (if enabled)
-    // ═══════════════════════════════════════════════════════════
-    if (options.enable_diarization && !options.diarization_model_path.empty()) {
-        try {
-            std::cout << "\n[Muninn] Running speaker diarization...\n";
-
-            // Initialize diarizer
-            DiarizationOptions diar_opts;
-            diar_opts.embedding_model_path = options.diarization_model_path;
-            diar_opts.clustering_threshold = options.diarization_threshold;
-            diar_opts.min_speakers = options.diarization_min_speakers;
-            diar_opts.max_speakers = options.diarization_max_speakers;
-
-            Diarizer diarizer(options.diarization_model_path, diar_opts);
-
-            // Re-open audio file for diarization
-            AudioExtractor diar_extractor;
-            if (!diar_extractor.open(audio_path)) {
-                throw std::runtime_error("Failed to open audio for diarization: " + diar_extractor.get_last_error());
-            }
-
-            // Run diarization on each track that has segments
-            std::map<int, DiarizationResult> track_diarization;
-            for (int track = 0; track < track_count; ++track) {
-                // Check if this track has any segments
-                bool has_segments = false;
-                for (const auto& seg : combined_result.segments) {
-                    if (seg.track_id == track) {
-                        has_segments = true;
-                        break;
-                    }
-                }
-
-                if (!has_segments) continue;
-
-                std::cout << "[Diarization] Processing Track " << track << "...\n";
-
-                // Extract audio for this track
-                std::vector<float> track_audio;
-                if (!diar_extractor.extract_track(track, track_audio)) {
-                    std::cerr << "[Diarization] WARNING: Failed to extract track " << track << "\n";
-                    continue;
-                }
-
-                // Run diarization
-                auto diar_result = diarizer.diarize(track_audio.data(), track_audio.size(), 16000);
-
-                std::cout << "[Diarization] Track " << track << ": Detected "
-                          << diar_result.num_speakers << " speaker(s)\n";
-
-                track_diarization[track] = diar_result;
-            }
-
-            diar_extractor.close();
-
-            // Assign speakers to all segments
-            for (auto& segment : combined_result.segments) {
-                if (track_diarization.count(segment.track_id) > 0) {
-                    const auto& diar_result = track_diarization[segment.track_id];
-
-                    // Find speaker at segment midpoint
-                    float midpoint = (segment.start + segment.end) / 2.0f;
-                    int speaker_id = Diarizer::get_speaker_at_time(diar_result, midpoint);
-
-                    if (speaker_id >= 0) {
-                        segment.speaker_id = speaker_id;
-                        segment.speaker_label = "Speaker " + std::to_string(speaker_id);
-
-                        // Calculate confidence based on segment overlap
-                        segment.speaker_confidence = 0.8f;  // Default confidence
-                    }
-                }
-            }
-
-            std::cout << "[Muninn] ✓ Speaker diarization complete\n";
+    // Join outstanding diarization (also after cancellation: the tasks own their audio)
+    for (auto& job : pending_diarization) {
+        finish_diarization(job);
+    }
 
-        } catch (const std::exception& e) {
-            std::cerr << "[Muninn] Warning: Diarization failed: " << e.what() << "\n";
-            std::cerr << "[Muninn] Continuing without speaker labels...\n";
-        }
+    if (diarizer) {
+        std::cout << "[Muninn] ✓ Speaker diarization complete\n";
     }
 
     return combined_result;
@@ -2653,10 +2749,16 @@ Transcriber::DeviceInfo Transcriber::get_device_info() const {
         info.device_index = 0;
         info.gpu_name = "";
         info.gpu_memory_mb = 0;
+        info.load_time_ms = 0.0;
+        info.shared_weights = false;
+        info.warmup_time_ms = 0.0;
         return info;
     }
 
     info.device = pimpl_->using_cuda ? "cuda" : "cpu";
+    info.load_time_ms = pimpl_->load_info.load_time_ms;
+    info.shared_weights = pimpl_->load_info.shared;
+    info.warmup_time_ms = pimpl_->warmup_time_ms;
     info.compute_type = pimpl_->compute_type_str;
     info.is_cuda = pimpl_->using_cuda;
     info.device_index = pimpl_->device_index;
@@ -2679,6 +2781,10 @@ Transcriber::DeviceInfo Transcriber::get_device_info() const {
     return info;
 }
 
+void Transcriber::set_segment_callback(SegmentCallback callback) {
+    pimpl_->segment_callback = std::move(callback);
+}
+
 void Transcriber::cancel() {
     pimpl_->cancelled.store(true, std::memory_order_release);
     std::cout << "[Muninn] Cancellation requested\n";
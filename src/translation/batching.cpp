@@ -0,0 +1,79 @@
+#include "batching.h"
+#include "muninn/translation_cache.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace muninn {
+namespace translation {
+
+std::vector<std::vector<size_t>> plan_batches(
+    const std::vector<std::vector<std::string>>& sources,
+    const TranslationOptions& options)
+{
+    std::vector<size_t> order(sources.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    if (options.sort_by_length) {
+        std::stable_sort(order.begin(), order.end(), [&sources](size_t a, size_t b) {
+            return sources[a].size() < sources[b].size();
+        });
+    }
+
+    const bool by_tokens = options.batch_type != "examples";
+    const size_t budget = static_cast<size_t>(std::max(0, options.max_batch_size));
+
+    std::vector<std::vector<size_t>> batches;
+    std::vector<size_t> current;
+    size_t longest = 0;
+
+    for (size_t index : order) {
+        size_t next_longest = std::max(longest, sources[index].size());
+        size_t cost = by_tokens ? next_longest * (current.size() + 1) : current.size() + 1;
+
+        if (!current.empty() && budget > 0 && cost > budget) {
+            batches.push_back(std::move(current));
+            current.clear();
+            next_longest = sources[index].size();
+        }
+
+        current.push_back(index);
+        longest = next_longest;
+    }
+    if (!current.empty()) {
+        batches.push_back(std::move(current));
+    }
+    return batches;
+}
+
+DedupPlan dedup_texts(const std::vector<std::string>& texts) {
+    DedupPlan plan;
+    plan.slot.resize(texts.size());
+
+    std::unordered_map<std::string, size_t> seen;
+    for (size_t i = 0; i < texts.size(); ++i) {
+        std::string key = TranslationCache::normalize(texts[i]);
+        auto [it, inserted] = seen.emplace(key, plan.first.size());
+        if (inserted) {
+            plan.first.push_back(i);
+            plan.keys.push_back(std::move(key));
+        }
+        plan.slot[i] = it->second;
+    }
+    return plan;
+}
+
+void fan_out(const DedupPlan& plan,
+             const std::vector<std::string>& translations,
+             const std::vector<bool>& have,
+             std::vector<std::string>& out)
+{
+    for (size_t i = 0; i < plan.slot.size(); ++i) {
+        if (have[plan.slot[i]]) {
+            out[i] = translations[plan.slot[i]];
+        }
+    }
+}
+
+} // namespace translation
+} // namespace muninn
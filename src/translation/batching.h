@@ -0,0 +1,53 @@
+#pragma once
+
+#include "muninn/translator.h"
+#include <string>
+#include <vector>
+
+namespace muninn {
+namespace translation {
+
+/**
+ * Group inputs into model batches
+ *
+ * Inputs are visited shortest-first (if sort_by_length, ties keep input
+ * order) and a batch is closed when adding the next input would exceed the
+ * budget: padded tokens (longest x count) for batch_type "tokens", inputs
+ * for "examples". An input larger than the whole budget gets a batch of its
+ * own; max_batch_size 0 puts everything in one batch.
+ *
+ * @param sources Tokenised inputs (only their lengths are used)
+ * @return Input indices per batch; every index appears exactly once
+ */
+std::vector<std::vector<size_t>> plan_batches(
+    const std::vector<std::vector<std::string>>& sources,
+    const TranslationOptions& options);
+
+/**
+ * Repeated texts of one request, collapsed to one entry per distinct text
+ */
+struct DedupPlan {
+    std::vector<size_t> slot;           // Distinct-text index of each input
+    std::vector<size_t> first;          // Input index of each distinct text's first occurrence
+    std::vector<std::string> keys;      // Normalised text (TranslationCache key) per distinct text
+};
+
+/**
+ * Group texts that are equal after TranslationCache::normalize()
+ */
+DedupPlan dedup_texts(const std::vector<std::string>& texts);
+
+/**
+ * Copy each distinct text's translation to every input that shares it
+ *
+ * @param translations Translation per distinct text
+ * @param have Whether each distinct text was translated; inputs of the others keep out's value
+ * @param out One entry per input (typically pre-filled with the originals)
+ */
+void fan_out(const DedupPlan& plan,
+             const std::vector<std::string>& translations,
+             const std::vector<bool>& have,
+             std::vector<std::string>& out);
+
+} // namespace translation
+} // namespace muninn
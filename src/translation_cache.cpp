@@ -0,0 +1,296 @@
+#include "muninn/translation_cache.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace muninn {
+
+namespace {
+
+constexpr char kMagic[4] = {'M', 'T', 'R', 'C'};
+constexpr uint32_t kVersion = 1;
+
+// Per-entry bookkeeping (list node + hash node) counted against the budget
+constexpr size_t kEntryOverhead = 64;
+
+// FNV-1a over raw bytes
+uint64_t fnv1a(const void* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Fields separated by NUL so "en"+"es..." can never collide with "ene"+"s..."
+std::string make_key(const std::string& source_lang, const std::string& target_lang,
+                     uint64_t options_hash, const std::string& normalized_text) {
+    std::string key;
+    key.reserve(source_lang.size() + target_lang.size() + sizeof(options_hash) + normalized_text.size() + 3);
+    key += source_lang;
+    key += '\0';
+    key += target_lang;
+    key += '\0';
+    key.append(reinterpret_cast<const char*>(&options_hash), sizeof(options_hash));
+    key += '\0';
+    key += normalized_text;
+    return key;
+}
+
+} // anonymous namespace
+
+// ═══════════════════════════════════════════════════════════
+// Implementation
+// ═══════════════════════════════════════════════════════════
+
+class TranslationCache::Impl {
+public:
+    struct Entry {
+        std::string key;
+        std::string translation;
+    };
+
+    TranslationCacheOptions options;
+
+    mutable std::mutex mutex;
+    std::list<Entry> lru;  // Most recently used at the front
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    TranslationCacheStats stats;
+
+    // Own lock so file I/O can report errors without holding the cache mutex
+    mutable std::mutex error_mutex;
+    std::string last_error;
+
+    void set_error(const std::string& error) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        last_error = error;
+        if (!error.empty()) {
+            std::cerr << "[TranslationCache] " << error << "\n";
+        }
+    }
+
+    static size_t entry_bytes(const std::string& key, const std::string& translation) {
+        // Key is held by both the list entry and the index
+        return 2 * key.size() + translation.size() + kEntryOverhead;
+    }
+
+    // Caller holds the mutex
+    void put(std::string key, const std::string& translation) {
+        auto found = index.find(key);
+        if (found != index.end()) {
+            auto entry = found->second;
+            stats.bytes -= entry_bytes(entry->key, entry->translation);
+            entry->translation = translation;
+            stats.bytes += entry_bytes(entry->key, entry->translation);
+            lru.splice(lru.begin(), lru, entry);
+        } else {
+            size_t bytes = entry_bytes(key, translation);
+            if (bytes > options.max_bytes) {
+                return;  // Would evict everything and still not fit
+            }
+            lru.push_front({std::move(key), translation});
+            index.emplace(lru.front().key, lru.begin());
+            stats.bytes += bytes;
+        }
+
+        while (stats.bytes > options.max_bytes && !lru.empty()) {
+            const Entry& victim = lru.back();
+            stats.bytes -= entry_bytes(victim.key, victim.translation);
+            index.erase(victim.key);
+            lru.pop_back();
+            ++stats.evictions;
+        }
+        stats.entries = lru.size();
+    }
+};
+
+// ═══════════════════════════════════════════════════════════
+// TranslationCache
+// ═══════════════════════════════════════════════════════════
+
+TranslationCache::TranslationCache(const TranslationCacheOptions& options)
+    : pimpl_(std::make_unique<Impl>())
+{
+    pimpl_->options = options;
+
+    if (!options.persist_path.empty()) {
+        std::ifstream probe(options.persist_path, std::ios::binary);
+        if (probe) {
+            probe.close();
+            load(options.persist_path);
+        }
+    }
+}
+
+TranslationCache::~TranslationCache() {
+    if (!pimpl_->options.persist_path.empty()) {
+        save(pimpl_->options.persist_path);
+    }
+}
+
+bool TranslationCache::lookup(const std::string& source_lang, const std::string& target_lang,
+                              uint64_t options_hash, const std::string& normalized_text,
+                              std::string& translation) {
+    std::string key = make_key(source_lang, target_lang, options_hash, normalized_text);
+
+    std::lock_guard<std::mutex> lock(pimpl_->mutex);
+    auto found = pimpl_->index.find(key);
+    if (found == pimpl_->index.end()) {
+        ++pimpl_->stats.misses;
+        return false;
+    }
+
+    pimpl_->lru.splice(pimpl_->lru.begin(), pimpl_->lru, found->second);
+    translation = found->second->translation;
+    ++pimpl_->stats.hits;
+    return true;
+}
+
+void TranslationCache::insert(const std::string& source_lang, const std::string& target_lang,
+                              uint64_t options_hash, const std::string& normalized_text,
+                              const std::string& translation) {
+    std::string key = make_key(source_lang, target_lang, options_hash, normalized_text);
+
+    std::lock_guard<std::mutex> lock(pimpl_->mutex);
+    pimpl_->put(std::move(key), translation);
+}
+
+bool TranslationCache::load(const std::string& path) {
+    pimpl_->set_error("");
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        pimpl_->set_error("Failed to open translation cache: " + path);
+        return false;
+    }
+    const uint64_t file_size = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t count = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion) {
+        pimpl_->set_error("Not a translation cache file (or unsupported version): " + path);
+        return false;
+    }
+
+    // Entries are stored least recently used first, so inserting in file order
+    // leaves the most recent ones at the front
+    // Sizes are checked against the bytes left in the file (and the budget)
+    // before allocating, so a corrupt header cannot request gigabytes
+    std::lock_guard<std::mutex> lock(pimpl_->mutex);
+    const uint64_t max_field = pimpl_->options.max_bytes;
+    auto field_fits = [&](uint32_t size) {
+        uint64_t remaining = file_size - static_cast<uint64_t>(in.tellg());
+        return size <= remaining && size <= max_field;
+    };
+
+    uint32_t loaded = 0;
+    for (; loaded < count; ++loaded) {
+        uint32_t key_size = 0;
+        uint32_t value_size = 0;
+        if (!in.read(reinterpret_cast<char*>(&key_size), sizeof(key_size)) || !field_fits(key_size)) break;
+        std::string key(key_size, '\0');
+        if (!in.read(key.data(), key_size)) break;
+        if (!in.read(reinterpret_cast<char*>(&value_size), sizeof(value_size)) || !field_fits(value_size)) break;
+        std::string value(value_size, '\0');
+        if (!in.read(value.data(), value_size)) break;
+        pimpl_->put(std::move(key), value);
+    }
+
+    if (loaded < count) {
+        pimpl_->set_error("Truncated or corrupt translation cache: " + path + " (kept " +
+                          std::to_string(loaded) + " of " + std::to_string(count) + " entries)");
+        return false;
+    }
+
+    std::cout << "[TranslationCache] Loaded " << loaded << " entries from " << path << "\n";
+    return true;
+}
+
+bool TranslationCache::save(const std::string& path) {
+    pimpl_->set_error("");
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        pimpl_->set_error("Failed to write translation cache: " + path);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(pimpl_->mutex);
+    uint32_t count = static_cast<uint32_t>(pimpl_->lru.size());
+    out.write(kMagic, sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    for (auto it = pimpl_->lru.rbegin(); it != pimpl_->lru.rend(); ++it) {
+        uint32_t key_size = static_cast<uint32_t>(it->key.size());
+        uint32_t value_size = static_cast<uint32_t>(it->translation.size());
+        out.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+        out.write(it->key.data(), key_size);
+        out.write(reinterpret_cast<const char*>(&value_size), sizeof(value_size));
+        out.write(it->translation.data(), value_size);
+    }
+
+    if (!out) {
+        pimpl_->set_error("Failed to write translation cache: " + path);
+        return false;
+    }
+    return true;
+}
+
+void TranslationCache::clear() {
+    std::lock_guard<std::mutex> lock(pimpl_->mutex);
+    pimpl_->lru.clear();
+    pimpl_->index.clear();
+    pimpl_->stats.entries = 0;
+    pimpl_->stats.bytes = 0;
+}
+
+std::string TranslationCache::get_last_error() const {
+    std::lock_guard<std::mutex> lock(pimpl_->error_mutex);
+    return pimpl_->last_error;
+}
+
+TranslationCacheStats TranslationCache::stats() const {
+    std::lock_guard<std::mutex> lock(pimpl_->mutex);
+    return pimpl_->stats;
+}
+
+std::string TranslationCache::normalize(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+
+    bool pending_space = false;
+    for (char c : text) {
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v') {
+            pending_space = !result.empty();
+            continue;
+        }
+        if (pending_space) {
+            result += ' ';
+            pending_space = false;
+        }
+        result += c;
+    }
+    return result;
+}
+
+uint64_t TranslationCache::options_hash(const TranslationOptions& options, const std::string& model_id) {
+    uint64_t hash = fnv1a(model_id.data(), model_id.size());
+    hash = fnv1a(&options.beam_size, sizeof(options.beam_size), hash);
+    hash = fnv1a(&options.length_penalty, sizeof(options.length_penalty), hash);
+    hash = fnv1a(&options.max_length, sizeof(options.max_length), hash);
+    hash = fnv1a(&options.repetition_penalty, sizeof(options.repetition_penalty), hash);
+    hash = fnv1a(&options.no_repeat_ngram_size, sizeof(options.no_repeat_ngram_size), hash);
+    return hash;
+}
+
+} // namespace muninn
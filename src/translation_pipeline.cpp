@@ -0,0 +1,216 @@
+#include "muninn/translation_pipeline.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+namespace muninn {
+
+// ═══════════════════════════════════════════════════════════
+// Implementation
+// ═══════════════════════════════════════════════════════════
+
+class TranslationPipeline::Impl {
+public:
+    Translator& translator;
+    TranslationPipelineOptions options;
+    std::vector<std::string> targets;         // target_langs, or just target_lang
+    std::atomic<bool> background{false};
+
+    std::mutex mutex;
+    std::condition_variable work_available;   // Worker: queue non-empty or stopping
+    std::condition_variable space_available;  // submit(): in_flight dropped below the limit
+    std::condition_variable all_done;         // finish(): in_flight reached zero
+
+    std::deque<size_t> queue;                 // Indices into segments awaiting translation
+    std::vector<Segment> segments;            // Every submitted segment, in submission order
+    size_t in_flight = 0;                     // Queued + translating
+    bool stopping = false;
+
+    std::thread worker;
+
+    Impl(Translator& t, const TranslationPipelineOptions& opts)
+        : translator(t), options(opts)
+    {
+        options.max_in_flight = std::max<size_t>(1, options.max_in_flight);
+        options.max_batch_segments = std::max<size_t>(1, options.max_batch_segments);
+        targets = options.target_langs.empty() ? std::vector<std::string>{options.target_lang}
+                                               : options.target_langs;
+        worker = std::thread([this] { run(); });
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            queue.clear();
+        }
+        work_available.notify_all();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    void submit(const std::vector<Segment>& batch) {
+        for (const auto& segment : batch) {
+            std::unique_lock<std::mutex> lock(mutex);
+            space_available.wait(lock, [this] { return in_flight < options.max_in_flight || stopping; });
+            if (stopping) {
+                return;
+            }
+            segments.push_back(segment);
+            queue.push_back(segments.size() - 1);
+            ++in_flight;
+            lock.unlock();
+            work_available.notify_one();
+        }
+    }
+
+    void wait_idle() {
+        std::unique_lock<std::mutex> lock(mutex);
+        all_done.wait(lock, [this] { return in_flight == 0; });
+    }
+
+    // Worker: take up to max_batch_segments, translate per source language
+    void run() {
+        while (true) {
+            std::vector<size_t> indices;
+            std::vector<std::pair<std::string, std::string>> work;  // (source language, text)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                work_available.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (stopping) {
+                    return;
+                }
+                while (!queue.empty() && indices.size() < options.max_batch_segments) {
+                    size_t index = queue.front();
+                    queue.pop_front();
+                    indices.push_back(index);
+                    const Segment& segment = segments[index];
+                    work.emplace_back(options.source_lang.empty() ? segment.language : options.source_lang,
+                                      segment.text);
+                }
+            }
+
+            // One call per source language in this batch (all targets at once)
+            std::map<std::string, std::vector<size_t>> by_language;
+            for (size_t i = 0; i < work.size(); ++i) {
+                by_language[work[i].first].push_back(i);
+            }
+
+            TranslationOptions translation_options = options.translation;
+            if (background.load(std::memory_order_relaxed) && options.background_max_batch_size > 0) {
+                translation_options.max_batch_size =
+                    translation_options.max_batch_size > 0
+                        ? std::min(translation_options.max_batch_size, options.background_max_batch_size)
+                        : options.background_max_batch_size;
+            }
+
+            // translations[i][t]: work item i, target t
+            std::vector<std::vector<std::string>> translations(work.size());
+            std::vector<bool> translated(work.size(), false);
+            for (const auto& [source_lang, members] : by_language) {
+                if (source_lang.empty() || source_lang == "auto") {
+                    continue;  // Unknown language: leave untranslated
+                }
+                std::vector<std::string> texts;
+                texts.reserve(members.size());
+                for (size_t i : members) {
+                    texts.push_back(work[i].second);
+                }
+                try {
+                    auto results = translator.translate_batch_multi_target(texts, source_lang, targets,
+                                                                           translation_options);
+                    for (size_t k = 0; k < members.size(); ++k) {
+                        auto& out = translations[members[k]];
+                        for (auto& [target, target_texts] : results) {
+                            out.push_back(k < target_texts.size() ? std::move(target_texts[k]) : texts[k]);
+                        }
+                        translated[members[k]] = true;
+                    }
+                } catch (const std::exception& e) {
+                    std::cerr << "[TranslationPipeline] Translation failed: " << e.what() << "\n";
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (size_t i = 0; i < indices.size(); ++i) {
+                    if (!translated[i] || translations[i].empty()) {
+                        continue;
+                    }
+                    Segment& segment = segments[indices[i]];
+                    segment.translated_text = translations[i][0];
+                    segment.translation_target = targets[0];
+                    if (targets.size() > 1) {
+                        segment.translations.clear();
+                        for (size_t t = 0; t < targets.size(); ++t) {
+                            segment.translations.emplace_back(targets[t], std::move(translations[i][t]));
+                        }
+                    }
+                }
+                in_flight -= indices.size();
+            }
+            space_available.notify_all();
+            all_done.notify_all();
+        }
+    }
+};
+
+// ═══════════════════════════════════════════════════════════
+// TranslationPipeline
+// ═══════════════════════════════════════════════════════════
+
+TranslationPipeline::TranslationPipeline(Translator& translator, const TranslationPipelineOptions& options)
+    : pimpl_(std::make_unique<Impl>(translator, options))
+{
+}
+
+TranslationPipeline::~TranslationPipeline() = default;
+
+void TranslationPipeline::submit(const std::vector<Segment>& segments) {
+    pimpl_->submit(segments);
+}
+
+void TranslationPipeline::set_background(bool background) {
+    pimpl_->background.store(background, std::memory_order_relaxed);
+}
+
+SegmentCallback TranslationPipeline::segment_callback() {
+    return [this](const std::vector<Segment>& segments) { submit(segments); };
+}
+
+std::vector<Segment> TranslationPipeline::finish() {
+    pimpl_->wait_idle();
+    std::lock_guard<std::mutex> lock(pimpl_->mutex);
+    return std::move(pimpl_->segments);
+}
+
+void TranslationPipeline::finish(TranscribeResult& result) {
+    auto translated = finish();
+
+    // (track, start, end) -> translated segments, in submission order
+    std::map<std::tuple<int, float, float>, std::deque<const Segment*>> by_key;
+    for (const auto& segment : translated) {
+        by_key[{segment.track_id, segment.start, segment.end}].push_back(&segment);
+    }
+
+    for (auto& segment : result.segments) {
+        auto it = by_key.find({segment.track_id, segment.start, segment.end});
+        if (it == by_key.end() || it->second.empty()) {
+            continue;
+        }
+        const Segment* source = it->second.front();
+        it->second.pop_front();
+        segment.translated_text = source->translated_text;
+        segment.translation_target = source->translation_target;
+        segment.translations = source->translations;
+    }
+}
+
+} // namespace muninn
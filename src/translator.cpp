@@ -1,13 +1,20 @@
 #include "muninn/translator.h"
+#include "muninn/translation_cache.h"
+#include "ct2/model_registry.h"
+#include "translation/batching.h"
 #include <ctranslate2/translator.h>
 #include <unordered_map>
-#include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <filesystem>
 #include <mutex>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <thread>
 
 #ifdef MUNINN_USE_SENTENCEPIECE
@@ -102,18 +109,109 @@ static const std::vector<TranslationLanguage> SUPPORTED_LANGUAGES = {
     {"he", "heb_Hebr", "Hebrew"},
 };
 
+// ═══════════════════════════════════════════════════════════════════════════
+// Tokenizer Worker Pool
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Persistent workers for SentencePiece encode/decode. The calling thread
+// takes part in every run, so a pool of size N keeps N-1 threads parked.
+class TokenizerPool {
+public:
+    explicit TokenizerPool(size_t size) : size_(std::max<size_t>(1, size)) {
+        workers_.reserve(size_ - 1);
+        for (size_t i = 1; i < size_; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    ~TokenizerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        task_available_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    TokenizerPool(const TokenizerPool&) = delete;
+    TokenizerPool& operator=(const TokenizerPool&) = delete;
+
+    size_t size() const { return size_; }
+
+    // Run part(0..parts-1): parts 1.. on the workers, part 0 on the caller; blocks until all finish
+    void run(size_t parts, const std::function<void(size_t)>& part) {
+        struct Latch {
+            std::mutex mutex;
+            std::condition_variable done;
+            size_t remaining;
+        } latch;
+        latch.remaining = parts - 1;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t p = 1; p < parts; ++p) {
+                tasks_.emplace_back([&part, &latch, p] {
+                    part(p);
+                    std::lock_guard<std::mutex> latch_lock(latch.mutex);
+                    if (--latch.remaining == 0) {
+                        latch.done.notify_one();
+                    }
+                });
+            }
+        }
+        task_available_.notify_all();
+
+        part(0);
+
+        std::unique_lock<std::mutex> latch_lock(latch.mutex);
+        latch.done.wait(latch_lock, [&latch] { return latch.remaining == 0; });
+    }
+
+private:
+    void work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                task_available_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (stopping_ && tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    size_t size_;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable task_available_;
+    std::deque<std::function<void()>> tasks_;
+    bool stopping_ = false;
+};
+
 // ═══════════════════════════════════════════════════════════════════════════
 // Implementation
 // ═══════════════════════════════════════════════════════════════════════════
 
 class Translator::Impl {
 public:
-    std::unique_ptr<ctranslate2::Translator> model;
+    std::shared_ptr<ctranslate2::Translator> model;  // Shared through ct2::acquire_translator
     std::string device_str;
     std::string model_path_;
+    std::string model_id;  // Canonical model path, part of the cache key
     bool loaded = false;
     std::atomic<bool> shutdown_requested{false};
     std::atomic<bool> cancelled{false};
+    std::shared_ptr<TranslationCache> cache;
+
+    // Created on first use, rebuilt only if tokenizer_threads changes
+    mutable std::mutex pool_mutex;
+    mutable std::shared_ptr<TokenizerPool> tokenizer_pool;
 
 #ifdef MUNINN_USE_SENTENCEPIECE
     sentencepiece::SentencePieceProcessor sp_processor;
@@ -133,8 +231,8 @@ public:
 
         loaded = false;
 
-        // Destroy CTranslate2 model first - this triggers ThreadPool shutdown
-        // which can block on CUDA synchronization
+        // Release CTranslate2 model first - the last reference triggers ThreadPool
+        // shutdown which can block on CUDA synchronization
         if (model) {
             std::cout << "[Muninn] Translator shutting down...\n";
             model.reset();
@@ -145,11 +243,16 @@ public:
     Impl(const std::string& model_path,
          const std::string& device,
          const std::string& compute_type,
-         int device_index)
+         int device_index,
+         int intra_threads)
         : device_str(device), model_path_(model_path)
     {
         init_reverse_mapping();
 
+        std::error_code ec;
+        auto canonical = std::filesystem::weakly_canonical(model_path, ec);
+        model_id = ec ? model_path : canonical.string();
+
         try {
             // Determine device
             ctranslate2::Device ct_device;
@@ -159,13 +262,14 @@ public:
                 ct_device = ctranslate2::Device::CPU;
             }
 
-            // Create translator
-            model = std::make_unique<ctranslate2::Translator>(
-                model_path,
-                ct_device,
-                ctranslate2::str_to_compute_type(compute_type),
-                std::vector<int>{device_index}
-            );
+            // Create translator (or share one already loaded with the same settings)
+            ct2::ModelKey key;
+            key.path = model_path;
+            key.device = ct_device;
+            key.device_index = device_index;
+            key.compute_type = compute_type;
+            key.intra_threads = static_cast<size_t>(std::max(0, intra_threads));
+            model = ct2::acquire_translator(key);
 
             loaded = true;
             std::cout << "[Muninn] Translator loaded: " << model_path
@@ -194,31 +298,102 @@ public:
         }
     }
 
-    // Tokenize text using SentencePiece (or fallback to whitespace)
-    std::vector<std::string> tokenize(const std::string& text) {
+    // Run fn(i) for i in [0, count) on the tokenizer pool, sized by `threads` (0 = auto).
+    // Each worker takes a contiguous range; small inputs stay on the caller.
+    template <typename Fn>
+    void parallel_for(size_t count, int threads, Fn&& fn) const {
+        constexpr size_t kMinPerWorker = 32;
+
+        size_t pool_size = threads > 0 ? static_cast<size_t>(threads)
+                                       : std::min<size_t>(8, std::max(1u, std::thread::hardware_concurrency()));
+        size_t workers = std::min(pool_size, count / kMinPerWorker);
+
+        if (workers <= 1) {
+            for (size_t i = 0; i < count; ++i) {
+                fn(i);
+            }
+            return;
+        }
+
+        std::shared_ptr<TokenizerPool> pool;
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            if (!tokenizer_pool || tokenizer_pool->size() != pool_size) {
+                tokenizer_pool = std::make_shared<TokenizerPool>(pool_size);
+            }
+            pool = tokenizer_pool;
+        }
+
+        std::vector<std::exception_ptr> errors(workers);
+        pool->run(workers, [&fn, &errors, count, workers](size_t w) {
+            try {
+                for (size_t i = count * w / workers; i < count * (w + 1) / workers; ++i) {
+                    fn(i);
+                }
+            } catch (...) {
+                errors[w] = std::current_exception();
+            }
+        });
+
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    // Fallback tokenizer: split on ASCII whitespace
+    static void split_whitespace(const std::string& text, std::vector<std::string>& tokens) {
+        auto is_space = [](char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+        };
+        size_t i = 0;
+        while (i < text.size()) {
+            while (i < text.size() && is_space(text[i])) ++i;
+            size_t start = i;
+            while (i < text.size() && !is_space(text[i])) ++i;
+            if (i > start) {
+                tokens.emplace_back(text, start, i - start);
+            }
+        }
+    }
+
+    // Encode text as an NLLB source: [source_lang_token, pieces..., </s>]
+    std::vector<std::string> encode(const std::string& text, const std::string& source_token) const {
         std::vector<std::string> tokens;
 
 #ifdef MUNINN_USE_SENTENCEPIECE
         if (sp_loaded) {
             auto status = sp_processor.Encode(text, &tokens);
             if (status.ok()) {
+                tokens.insert(tokens.begin(), source_token);
+                tokens.push_back("</s>");
                 return tokens;
             }
             std::cerr << "[Muninn] SentencePiece encode failed: " << status.ToString() << "\n";
+            tokens.clear();
         }
 #endif
 
-        // Fallback: simple whitespace tokenizer
-        std::istringstream iss(text);
-        std::string word;
-        while (iss >> word) {
-            tokens.push_back(word);
-        }
+        tokens.push_back(source_token);
+        split_whitespace(text, tokens);
+        tokens.push_back("</s>");
         return tokens;
     }
 
+    // Encode many texts across the tokenizer workers (SentencePiece is thread-safe for reads)
+    std::vector<std::vector<std::string>> encode_batch(const std::vector<const std::string*>& texts,
+                                                       const std::string& source_token,
+                                                       int threads) const {
+        std::vector<std::vector<std::string>> encoded(texts.size());
+        parallel_for(texts.size(), threads, [&](size_t i) {
+            encoded[i] = encode(*texts[i], source_token);
+        });
+        return encoded;
+    }
+
     // Detokenize using SentencePiece (or fallback to space-join)
-    std::string detokenize(const std::vector<std::string>& tokens) {
+    std::string detokenize(const std::vector<std::string>& tokens) const {
 #ifdef MUNINN_USE_SENTENCEPIECE
         if (sp_loaded) {
             std::string result;
@@ -231,18 +406,158 @@ public:
 #endif
 
         // Fallback: simple space-join
+        size_t length = tokens.size();
+        for (const auto& token : tokens) {
+            length += token.size();
+        }
         std::string result;
+        result.reserve(length);
         for (size_t i = 0; i < tokens.size(); ++i) {
-            if (i > 0) result += " ";
+            if (i > 0) result += ' ';
             result += tokens[i];
         }
         return result;
     }
 
+    static ctranslate2::TranslationOptions to_ct_options(const TranslationOptions& options) {
+        ctranslate2::TranslationOptions ct_options;
+        ct_options.beam_size = options.beam_size;
+        ct_options.length_penalty = options.length_penalty;
+        ct_options.repetition_penalty = options.repetition_penalty;
+        ct_options.no_repeat_ngram_size = options.no_repeat_ngram_size;
+        ct_options.max_decoding_length = options.max_length;
+        return ct_options;
+    }
+
+    /**
+     * Translate tokenised sources in length-bucketed batches
+     *
+     * @param sources NLLB source tokens ([src_lang, ..., </s>]); moved into the model batches
+     * @param prefixes Decoder prefixes ([</s>, tgt_lang])
+     * @param targets NLLB target code per input (for output cleanup)
+     * @param fallbacks Returned for inputs that fail or are cancelled
+     * @param completed If set, receives true for inputs the model translated
+     * @return Translations in input order
+     */
+    std::vector<std::string> translate_tokens(
+        std::vector<std::vector<std::string>> sources,
+        const std::vector<std::vector<std::string>>& prefixes,
+        const std::vector<std::string>& targets,
+        const std::vector<std::string>& fallbacks,
+        const TranslationOptions& options,
+        std::vector<bool>* completed = nullptr)
+    {
+        ctranslate2::TranslationOptions ct_options = to_ct_options(options);
+
+        // Greedy search reports every decoding step, so cancel() can stop a
+        // running batch at the next step. Beam search has no step callback;
+        // there cancel() stops waiting for the batch instead.
+        const bool step_cancel = options.beam_size <= 1;
+
+        std::vector<std::string> translations = fallbacks;
+        size_t finished_count = 0;
+        if (completed) {
+            completed->assign(sources.size(), false);
+        }
+        auto batches = translation::plan_batches(sources, options);
+
+        for (size_t b = 0; b < batches.size(); ++b) {
+            // Check for cancellation (remaining inputs keep their fallback)
+            if (cancelled.load(std::memory_order_acquire)) {
+                break;
+            }
+
+            const auto& batch = batches[b];
+            std::vector<std::vector<std::string>> batch_sources;
+            std::vector<std::vector<std::string>> batch_prefixes;
+            batch_sources.reserve(batch.size());
+            batch_prefixes.reserve(batch.size());
+            for (size_t index : batch) {
+                batch_sources.push_back(std::move(sources[index]));
+                batch_prefixes.push_back(prefixes[index]);
+            }
+
+            // One CTranslate2 job per planned batch (already within the budget),
+            // so the step callback's batch_id is the position in this batch
+            std::vector<char> reached_end(batch.size(), 0);
+            if (step_cancel) {
+                ct_options.callback = [this, &reached_end](ctranslate2::GenerationStepResult step) {
+                    if (step.is_last && step.batch_id < reached_end.size()) {
+                        reached_end[step.batch_id] = 1;
+                    }
+                    return cancelled.load(std::memory_order_acquire);  // true = stop decoding
+                };
+            }
+
+            try {
+                auto futures = model->translate_batch_async(batch_sources, batch_prefixes, ct_options);
+
+                // Collect finished examples; on cancel keep whatever already completed
+                std::vector<ctranslate2::TranslationResult> results(batch.size());
+                std::vector<char> done(batch.size(), 0);
+                bool abandoned = false;
+
+                for (size_t i = 0; i < futures.size() && i < batch.size(); ++i) {
+                    if (!step_cancel) {
+                        // No step callback: poll so cancel() is not stuck behind a long beam search
+                        while (futures[i].wait_for(std::chrono::milliseconds(20)) != std::future_status::ready) {
+                            if (cancelled.load(std::memory_order_acquire)) {
+                                abandoned = true;
+                                break;
+                            }
+                        }
+                        if (abandoned) {
+                            // Keep examples that finished anyway; the rest are left to the model
+                            for (size_t j = i; j < futures.size() && j < batch.size(); ++j) {
+                                if (futures[j].wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                                    results[j] = futures[j].get();
+                                    done[j] = !results[j].hypotheses.empty();
+                                }
+                            }
+                            break;
+                        }
+                    }
+
+                    results[i] = futures[i].get();
+                    // A stopped greedy decode returns a truncated hypothesis: only keep finished ones
+                    done[i] = !results[i].hypotheses.empty() && (!step_cancel || reached_end[i] ||
+                                                                 !cancelled.load(std::memory_order_acquire));
+                }
+
+                // Detokenize and clean results back into input order
+                parallel_for(batch.size(), options.tokenizer_threads, [&](size_t i) {
+                    if (done[i]) {
+                        translations[batch[i]] = clean_output(detokenize(results[i].hypotheses[0]),
+                                                              targets[batch[i]]);
+                    }
+                });
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    if (done[i]) {
+                        ++finished_count;
+                        if (completed) {
+                            (*completed)[batch[i]] = true;
+                        }
+                    }
+                }
+
+            } catch (const std::exception& e) {
+                std::cerr << "[Muninn] Translation error in batch " << b << " (" << batch.size()
+                          << " texts): " << e.what() << "\n";
+            }
+        }
+
+        if (cancelled.load(std::memory_order_acquire)) {
+            std::cout << "[Muninn] Translation cancelled (" << finished_count << " of " << sources.size()
+                      << " texts finished)\n";
+        }
+
+        return translations;
+    }
+
     // Clean up NLLB output (remove language tokens, fix spacing)
     // NOTE: Using simple string operations instead of std::regex for performance
     // std::regex is extremely slow in C++ and was causing hangs
-    std::string clean_output(const std::string& text, const std::string& target_nllb) {
+    std::string clean_output(const std::string& text, const std::string& target_nllb) const {
         std::string result = text;
 
         // Remove target language token if it appears at the start
@@ -299,8 +614,9 @@ public:
 Translator::Translator(const std::string& model_path,
                        const std::string& device,
                        const std::string& compute_type,
-                       int device_index)
-    : pimpl_(std::make_unique<Impl>(model_path, device, compute_type, device_index))
+                       int device_index,
+                       int intra_threads)
+    : pimpl_(std::make_unique<Impl>(model_path, device, compute_type, device_index, intra_threads))
 {}
 
 Translator::~Translator() = default;
@@ -316,111 +632,115 @@ std::string Translator::translate(const std::string& text,
     return results.empty() ? text : results[0];
 }
 
-std::vector<std::string> Translator::translate_batch(
-    const std::vector<std::string>& texts,
-    const std::string& source_lang,
-    const std::string& target_lang,
-    const TranslationOptions& options)
-{
-    if (texts.empty() || !pimpl_->loaded) {
-        return texts;
+std::string Translator::translate_streaming(const std::string& text,
+                                            const std::string& source_lang,
+                                            const std::string& target_lang,
+                                            const TranslationStreamCallback& callback,
+                                            const TranslationOptions& options) {
+    if (!pimpl_->loaded) {
+        return text;
     }
 
-    // Get NLLB codes
     std::string src_nllb = to_nllb_code(source_lang);
     std::string tgt_nllb = to_nllb_code(target_lang);
-
     if (src_nllb.empty() || tgt_nllb.empty()) {
         std::cerr << "[Muninn] Unsupported language pair: " << source_lang
                   << " -> " << target_lang << "\n";
-        return texts;
+        return text;
     }
-
-    // Skip translation if source == target
     if (src_nllb == tgt_nllb) {
-        return texts;
+        if (callback) callback(text, true);
+        return text;
     }
 
-    // Set translation options
-    ctranslate2::TranslationOptions ct_options;
-    ct_options.beam_size = options.beam_size;
-    ct_options.length_penalty = options.length_penalty;
-    ct_options.repetition_penalty = options.repetition_penalty;
-    ct_options.no_repeat_ngram_size = options.no_repeat_ngram_size;
-    ct_options.max_decoding_length = options.max_length;
+    // CTranslate2 only reports per-step tokens for greedy search
+    ctranslate2::TranslationOptions ct_options = Impl::to_ct_options(options);
+    ct_options.beam_size = 1;
+
+    // SentencePiece marks the start of a word with U+2581; a piece carrying it
+    // means the pieces before it form whole words. The fallback tokenizer
+    // yields whole words, so every piece completes one.
+    static const std::string kWordStart = "\xE2\x96\x81";
+#ifdef MUNINN_USE_SENTENCEPIECE
+    const bool word_pieces = pimpl_->sp_loaded;
+#else
+    const bool word_pieces = false;
+#endif
 
-    // Process in chunks to avoid GPU memory issues and hangs
-    // Chunk size of 8 is safe for most GPUs while still being efficient
-    const size_t CHUNK_SIZE = 8;
-    std::vector<std::string> all_translations;
-    all_translations.reserve(texts.size());
+    std::vector<std::string> pieces;
+    std::string emitted;
+    bool stopped = false;
 
-    for (size_t chunk_start = 0; chunk_start < texts.size(); chunk_start += CHUNK_SIZE) {
-        // Check for cancellation
+    ct_options.callback = [&](ctranslate2::GenerationStepResult step) {
         if (pimpl_->cancelled.load(std::memory_order_acquire)) {
-            std::cout << "[Muninn] Translation cancelled\n";
-            // Return what we have so far, fill rest with originals
-            for (size_t i = chunk_start; i < texts.size(); ++i) {
-                all_translations.push_back(texts[i]);
-            }
-            break;
+            stopped = true;
+            return true;  // true = stop decoding
+        }
+        if (step.token == "</s>" || step.token == tgt_nllb) {
+            return false;
         }
 
-        size_t chunk_end = std::min(chunk_start + CHUNK_SIZE, texts.size());
-
-        try {
-            // Tokenize inputs for this chunk
-            // NLLB format: [source_lang_token, tokens..., </s>]
-            std::vector<std::vector<std::string>> tokenized_inputs;
-            std::vector<std::vector<std::string>> target_prefixes;
-
-            for (size_t i = chunk_start; i < chunk_end; ++i) {
-                std::vector<std::string> tokens;
-                tokens.push_back(src_nllb);  // NLLB requires source lang token first
-
-                // Tokenize the text
-                auto text_tokens = pimpl_->tokenize(texts[i]);
-                tokens.insert(tokens.end(), text_tokens.begin(), text_tokens.end());
-
-                // Add EOS token at end of source
-                tokens.push_back("</s>");
-
-                tokenized_inputs.push_back(tokens);
-
-                // Target prefix: [</s>, target_lang_token] - NLLB decoder starts with </s>
-                target_prefixes.push_back({"</s>", tgt_nllb});
-            }
+        pieces.push_back(std::move(step.token));
+        if (!callback || step.is_last) {
+            return false;  // The final text is reported once decoding returns
+        }
 
-            // Translate this chunk
-            auto results = pimpl_->model->translate_batch(
-                tokenized_inputs,
-                target_prefixes,
-                ct_options
-            );
-
-            // Detokenize and clean results
-            for (size_t i = 0; i < results.size(); ++i) {
-                if (!results[i].hypotheses.empty()) {
-                    std::string translated = pimpl_->detokenize(results[i].hypotheses[0]);
-                    translated = pimpl_->clean_output(translated, tgt_nllb);
-                    all_translations.push_back(translated);
-                } else {
-                    // Fallback to original text
-                    all_translations.push_back(texts[chunk_start + i]);
-                }
+        // Whole words decoded so far
+        size_t complete = pieces.size();
+        if (word_pieces) {
+            if (pieces.back().compare(0, kWordStart.size(), kWordStart) != 0) {
+                return false;
             }
+            complete = pieces.size() - 1;
+        }
 
-        } catch (const std::exception& e) {
-            std::cerr << "[Muninn] Translation error in chunk " << (chunk_start / CHUNK_SIZE)
-                      << ": " << e.what() << "\n";
-            // On error, add original texts for this chunk
-            for (size_t i = chunk_start; i < chunk_end; ++i) {
-                all_translations.push_back(texts[i]);
-            }
+        std::vector<std::string> words(pieces.begin(), pieces.begin() + complete);
+        std::string partial = pimpl_->clean_output(pimpl_->detokenize(words), tgt_nllb);
+        if (partial.empty() || partial == emitted) {
+            return false;
+        }
+        emitted = partial;
+        if (!callback(partial, false)) {
+            stopped = true;
+            return true;
+        }
+        return false;
+    };
+
+    std::string result = text;
+    try {
+        auto results = pimpl_->model->translate_batch({pimpl_->encode(text, src_nllb)}, {{"</s>", tgt_nllb}},
+                                                      ct_options);
+        if (!results.empty() && !results[0].hypotheses.empty()) {
+            result = pimpl_->clean_output(pimpl_->detokenize(results[0].hypotheses[0]), tgt_nllb);
+        } else if (!pieces.empty()) {
+            result = pimpl_->clean_output(pimpl_->detokenize(pieces), tgt_nllb);
         }
+    } catch (const std::exception& e) {
+        std::cerr << "[Muninn] Streaming translation error: " << e.what() << "\n";
+        if (!pieces.empty()) {
+            result = pimpl_->clean_output(pimpl_->detokenize(pieces), tgt_nllb);
+        }
+    }
+
+    if (stopped) {
+        std::cout << "[Muninn] Streaming translation stopped after " << pieces.size() << " tokens\n";
+    }
+    if (callback) {
+        callback(result, true);
     }
+    return result;
+}
 
-    return all_translations;
+std::vector<std::string> Translator::translate_batch(
+    const std::vector<std::string>& texts,
+    const std::string& source_lang,
+    const std::string& target_lang,
+    const TranslationOptions& options)
+{
+    // Single-target case of the multi-target path (dedup, cache, bucketed batches)
+    auto results = translate_batch_multi_target(texts, source_lang, {target_lang}, options);
+    return std::move(results[0].second);
 }
 
 std::vector<std::pair<std::string, std::string>> Translator::translate_multi_target(
@@ -432,14 +752,147 @@ std::vector<std::pair<std::string, std::string>> Translator::translate_multi_tar
     std::vector<std::pair<std::string, std::string>> results;
     results.reserve(target_langs.size());
 
+    for (auto& [target, translations] : translate_batch_multi_target({text}, source_lang, target_langs, options)) {
+        results.emplace_back(target, translations.empty() ? text : translations[0]);
+    }
+
+    return results;
+}
+
+std::vector<std::pair<std::string, std::vector<std::string>>> Translator::translate_batch_multi_target(
+    const std::vector<std::string>& texts,
+    const std::string& source_lang,
+    const std::vector<std::string>& target_langs,
+    const TranslationOptions& options)
+{
+    std::vector<std::pair<std::string, std::vector<std::string>>> results;
+    results.reserve(target_langs.size());
     for (const auto& target : target_langs) {
-        std::string translated = translate(text, source_lang, target, options);
-        results.emplace_back(target, translated);
+        results.emplace_back(target, texts);  // Originals until translated
+    }
+
+    if (texts.empty() || !pimpl_->loaded) {
+        return results;
+    }
+
+    std::string src_nllb = to_nllb_code(source_lang);
+    if (src_nllb.empty()) {
+        std::cerr << "[Muninn] Unsupported source language: " << source_lang << "\n";
+        return results;
+    }
+
+    // Targets that need the model (unsupported or same-as-source keep the originals)
+    std::vector<size_t> active_targets;
+    std::vector<std::string> target_nllb(target_langs.size());
+    for (size_t t = 0; t < target_langs.size(); ++t) {
+        target_nllb[t] = to_nllb_code(target_langs[t]);
+        if (target_nllb[t].empty()) {
+            std::cerr << "[Muninn] Unsupported language pair: " << source_lang
+                      << " -> " << target_langs[t] << "\n";
+        } else if (target_nllb[t] != src_nllb) {
+            active_targets.push_back(t);
+        }
+    }
+    if (active_targets.empty()) {
+        return results;
+    }
+
+    // Collapse repeats: each distinct (normalised) text is translated once
+    const translation::DedupPlan dedup = translation::dedup_texts(texts);
+    const std::vector<size_t>& unique_texts = dedup.first;
+    const std::vector<std::string>& unique_keys = dedup.keys;
+
+    // Answer what the translation memory already knows
+    auto cache = pimpl_->cache;
+    const uint64_t options_hash = cache ? TranslationCache::options_hash(options, pimpl_->model_id) : 0;
+    std::vector<std::vector<std::string>> unique_results(active_targets.size(),
+                                                         std::vector<std::string>(unique_texts.size()));
+    std::vector<std::vector<bool>> have(active_targets.size(), std::vector<bool>(unique_texts.size(), false));
+
+    std::vector<std::pair<size_t, size_t>> pending;  // (active target, unique text)
+    for (size_t a = 0; a < active_targets.size(); ++a) {
+        for (size_t u = 0; u < unique_texts.size(); ++u) {
+            if (cache && cache->lookup(source_lang, target_langs[active_targets[a]], options_hash,
+                                       unique_keys[u], unique_results[a][u])) {
+                have[a][u] = true;
+            } else {
+                pending.emplace_back(a, u);
+            }
+        }
+    }
+
+    if (!pending.empty()) {
+        // Tokenize each needed text once, across the tokenizer workers:
+        // [source_lang_token, tokens..., </s>]
+        std::vector<size_t> encode_slot(unique_texts.size(), SIZE_MAX);
+        std::vector<const std::string*> to_encode;
+        for (const auto& [a, u] : pending) {
+            if (encode_slot[u] == SIZE_MAX) {
+                encode_slot[u] = to_encode.size();
+                to_encode.push_back(&texts[unique_texts[u]]);
+            }
+        }
+        auto tokenized_texts = pimpl_->encode_batch(to_encode, src_nllb, options.tokenizer_threads);
+        const bool single_use = active_targets.size() == 1;
+
+        // One input per (target, text) pair with its own target prefix
+        std::vector<std::vector<std::string>> sources;
+        std::vector<std::vector<std::string>> prefixes;
+        std::vector<std::string> targets;
+        std::vector<std::string> fallbacks;
+        sources.reserve(pending.size());
+        prefixes.reserve(pending.size());
+        targets.reserve(pending.size());
+        fallbacks.reserve(pending.size());
+
+        for (const auto& [a, u] : pending) {
+            const std::string& nllb = target_nllb[active_targets[a]];
+            auto& tokens = tokenized_texts[encode_slot[u]];
+            if (single_use) {
+                sources.push_back(std::move(tokens));  // Each text feeds exactly one input
+            } else {
+                sources.push_back(tokens);
+            }
+            prefixes.push_back({"</s>", nllb});
+            targets.push_back(nllb);
+            fallbacks.push_back(texts[unique_texts[u]]);
+        }
+
+        std::vector<bool> completed;
+        auto translations = pimpl_->translate_tokens(std::move(sources), prefixes, targets, fallbacks, options, &completed);
+
+        for (size_t p = 0; p < pending.size(); ++p) {
+            if (!completed[p]) {
+                continue;  // Failed or cancelled: keep the original text
+            }
+            const auto [a, u] = pending[p];
+            if (cache) {
+                cache->insert(source_lang, target_langs[active_targets[a]], options_hash,
+                              unique_keys[u], translations[p]);
+            }
+            unique_results[a][u] = std::move(translations[p]);
+            have[a][u] = true;
+        }
+    }
+
+    // Fan unique translations back out to every occurrence
+    for (size_t a = 0; a < active_targets.size(); ++a) {
+        translation::fan_out(dedup, unique_results[a], have[a], results[active_targets[a]].second);
     }
 
     return results;
 }
 
+void Translator::set_cache(std::shared_ptr<TranslationCache> cache) {
+    if (pimpl_) {
+        pimpl_->cache = std::move(cache);
+    }
+}
+
+std::shared_ptr<TranslationCache> Translator::cache() const {
+    return pimpl_ ? pimpl_->cache : nullptr;
+}
+
 bool Translator::is_language_supported(const std::string& lang_code) const {
     return CODE_TO_NLLB.count(lang_code) > 0;
 }
@@ -166,7 +166,7 @@ std::vector<SpeechSegment> VAD::post_process_segments(
     return result;
 }
 
-std::vector<float> VAD::filter_silence(
+SpeechView VAD::speech_view(
     const std::vector<float>& samples,
     int sample_rate,
     std::vector<SpeechSegment>& segments
@@ -190,27 +190,14 @@ std::vector<float> VAD::filter_silence(
 
         std::cout << "[VAD] No speech detected - returning original audio\n";
         silence_removed_ = 0.0f;
-        return samples;
+        return SpeechView(samples.data(), samples.size(), sample_rate);
     }
 
-    // Extract speech portions
-    std::vector<float> filtered;
+    // Reference speech portions in place (no copy)
     float total_duration = static_cast<float>(samples.size()) / sample_rate;
     float speech_duration = 0.0f;
 
     for (const auto& seg : segments) {
-        int start_sample = static_cast<int>(seg.start * sample_rate);
-        int end_sample = static_cast<int>(seg.end * sample_rate);
-
-        // Clamp to valid range
-        start_sample = std::max(0, start_sample);
-        end_sample = std::min(static_cast<int>(samples.size()), end_sample);
-
-        // Copy samples
-        filtered.insert(filtered.end(),
-                       samples.begin() + start_sample,
-                       samples.begin() + end_sample);
-
         speech_duration += seg.end - seg.start;
     }
 
@@ -220,7 +207,15 @@ std::vector<float> VAD::filter_silence(
     std::cout << "[VAD] Removed " << silence_removed_ << "s of silence ("
               << static_cast<int>(silence_removed_ / total_duration * 100) << "%)\n";
 
-    return filtered;
+    return SpeechView(samples.data(), samples.size(), segments, sample_rate);
+}
+
+std::vector<float> VAD::filter_silence(
+    const std::vector<float>& samples,
+    int sample_rate,
+    std::vector<SpeechSegment>& segments
+) {
+    return speech_view(samples, sample_rate, segments).to_vector();
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -228,35 +223,37 @@ std::vector<float> VAD::filter_silence(
 // ═══════════════════════════════════════════════════════════
 
 AudioCharacteristics analyze_audio_characteristics(const std::vector<float>& samples) {
+    // Single pass, no sort (statistics are histogram based)
+    AudioStatistics stats;
+    stats.add(samples.data(), samples.size());
+    stats.finish();
+    return analyze_audio_characteristics(stats);
+}
+
+AudioCharacteristics analyze_audio_characteristics(const AudioStatistics& stats) {
     AudioCharacteristics characteristics{};
 
-    if (samples.empty()) {
+    if (stats.sample_count == 0) {
         characteristics.is_silent = true;
         return characteristics;
     }
 
-    // Build sorted array of absolute amplitudes (sampled for performance)
-    std::vector<float> abs_samples;
-    abs_samples.reserve(samples.size() / 1000 + 1);
-
-    float max_amp = 0.0f;
-    for (size_t i = 0; i < samples.size(); i += 1000) {
-        float amp = std::abs(samples[i]);
-        abs_samples.push_back(amp);
-        max_amp = std::max(max_amp, amp);
-    }
-
-    std::sort(abs_samples.begin(), abs_samples.end());
-
-    // Calculate percentiles
-    size_t p10_idx = static_cast<size_t>(abs_samples.size() * 0.1);
-    size_t p90_idx = static_cast<size_t>(abs_samples.size() * 0.9);
-
-    characteristics.noise_floor = abs_samples[p10_idx];
-    characteristics.speech_level = abs_samples[p90_idx];
+    // Percentiles from the |amplitude| histogram
+    characteristics.noise_floor = stats.amplitude_percentile(0.1f);
+    characteristics.speech_level = stats.amplitude_percentile(0.9f);
     characteristics.dynamic_range = characteristics.speech_level - characteristics.noise_floor;
-    characteristics.max_amplitude = max_amp;
-    characteristics.is_silent = (max_amp < 0.0001f);
+    characteristics.max_amplitude = stats.peak;
+    characteristics.is_silent = (stats.peak < 0.0001f);
+
+    // Speech has pauses, so its frame levels spread widely; a loud track whose
+    // quietest frames sit close to its loudest is continuous programme audio
+    float level_p10 = stats.level_percentile_db(0.1f);
+    float level_p50 = stats.level_percentile_db(0.5f);
+    float level_p90 = stats.level_percentile_db(0.9f);
+    characteristics.level_spread_db = level_p90 - level_p10;
+    characteristics.is_music_like = !characteristics.is_silent &&
+                                    level_p50 > -35.0f &&
+                                    characteristics.level_spread_db < 12.0f;
 
     return characteristics;
 }
@@ -265,6 +262,22 @@ VADType auto_detect_vad_type(
     const std::vector<float>& samples,
     int track_id,
     int total_tracks
+) {
+    // Multi-track Track 0 needs no analysis (avoid the pass over samples)
+    if (total_tracks > 1 && track_id == 0) {
+        return auto_detect_vad_type(AudioStatistics(), track_id, total_tracks);
+    }
+
+    AudioStatistics stats;
+    stats.add(samples.data(), samples.size());
+    stats.finish();
+    return auto_detect_vad_type(stats, track_id, total_tracks);
+}
+
+VADType auto_detect_vad_type(
+    const AudioStatistics& stats,
+    int track_id,
+    int total_tracks
 ) {
     // Multi-track scenario: Track 0 is usually desktop/game audio with mixed content
     if (total_tracks > 1 && track_id == 0) {
@@ -274,12 +287,13 @@ VADType auto_detect_vad_type(
     }
 
     // Analyze audio characteristics
-    auto characteristics = analyze_audio_characteristics(samples);
+    auto characteristics = analyze_audio_characteristics(stats);
 
     std::cout << "[Auto-VAD] Track " << track_id
               << ": Noise=" << characteristics.noise_floor
               << ", Speech=" << characteristics.speech_level
-              << ", Range=" << characteristics.dynamic_range << "\n";
+              << ", Range=" << characteristics.dynamic_range
+              << ", LevelSpread=" << characteristics.level_spread_db << "dB\n";
 
     // Silent track
     if (characteristics.is_silent) {
@@ -300,6 +314,12 @@ VADType auto_detect_vad_type(
         return VADType::Silero;
     }
 
+    // Continuous music bed: RMS energy cannot separate speech from it
+    if (characteristics.is_music_like) {
+        std::cout << "[Auto-VAD] Track " << track_id << ": Continuous music/programme audio → WebRTC VAD\n";
+        return VADType::WebRTC;
+    }
+
     // Mixed/noisy content or low dynamic range
     std::cout << "[Auto-VAD] Track " << track_id << ": Mixed/noisy audio → Energy VAD\n";
     return VADType::Energy;
@@ -0,0 +1,426 @@
+#include "muninn/webrtc_vad.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <deque>
+#include <iostream>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace muninn {
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════
+// Model constants (log-energy domain, dB)
+// ═══════════════════════════════════════════════════════════
+
+constexpr int kNumBands = 6;
+constexpr int kNumGaussians = 2;
+
+// Sub-band edges in Hz (same split as the WebRTC VAD filter bank)
+constexpr float kBandEdgesHz[kNumBands + 1] = {80.0f, 250.0f, 500.0f, 1000.0f, 2000.0f, 3000.0f, 4000.0f};
+
+// Band weights for the global likelihood ratio test (WebRTC kSpectrumWeight)
+constexpr float kBandWeights[kNumBands] = {6.0f, 8.0f, 10.0f, 12.0f, 14.0f, 16.0f};
+
+// Decision thresholds per aggressiveness mode 0-3 (log-likelihood ratio, nats)
+constexpr float kGlobalThreshold[4] = {0.5f, 1.0f, 1.6f, 2.3f};   // Weighted mean over bands
+constexpr float kLocalThreshold[4] = {3.0f, 4.0f, 5.5f, 7.0f};    // Any single band
+
+constexpr float kMinEnergyDb = -70.0f;      // Frames below this are never speech (no adaptation)
+constexpr float kNoiseUpdateRate = 0.02f;   // Noise GMM learning rate (noise frames)
+constexpr float kSpeechUpdateRate = 0.01f;  // Speech GMM learning rate (speech frames)
+constexpr float kBackEta = 0.05f;           // Pull of the noise model toward the tracked minimum
+constexpr float kMinSpeechGapDb = 6.0f;     // Speech means stay this far above the noise mean
+constexpr float kMinStdDb = 1.5f;
+constexpr float kMaxStdDb = 15.0f;
+constexpr float kMinimumWindowS = 5.0f;     // Sliding window for noise-floor (minimum) tracking
+constexpr float kInitWindowS = 10.0f;       // Frames used to initialise the noise floor
+
+/**
+ * @brief Two-component Gaussian mixture over one band's log energy
+ */
+struct BandGMM {
+    float mean[kNumGaussians];
+    float stddev[kNumGaussians];
+    float weight[kNumGaussians];
+
+    // Per-component log(weight * N(x | mean, std))
+    void component_log_likelihoods(float x, float* out) const {
+        constexpr float kLogSqrt2Pi = 0.9189385f;
+        for (int j = 0; j < kNumGaussians; ++j) {
+            float z = (x - mean[j]) / stddev[j];
+            out[j] = std::log(weight[j]) - std::log(stddev[j]) - kLogSqrt2Pi - 0.5f * z * z;
+        }
+    }
+
+    float log_likelihood(float x) const {
+        float ll[kNumGaussians];
+        component_log_likelihoods(x, ll);
+        float m = std::max(ll[0], ll[1]);
+        return m + std::log(std::exp(ll[0] - m) + std::exp(ll[1] - m));
+    }
+
+    float global_mean() const {
+        return weight[0] * mean[0] + weight[1] * mean[1];
+    }
+
+    // One online EM step toward observation x
+    void update(float x, float rate) {
+        float ll[kNumGaussians];
+        component_log_likelihoods(x, ll);
+        float m = std::max(ll[0], ll[1]);
+        float r0 = std::exp(ll[0] - m);
+        float r1 = std::exp(ll[1] - m);
+        float resp[kNumGaussians] = {r0 / (r0 + r1), r1 / (r0 + r1)};
+
+        for (int j = 0; j < kNumGaussians; ++j) {
+            float step = rate * resp[j];
+            float delta = x - mean[j];
+            mean[j] += step * delta;
+            float var = stddev[j] * stddev[j];
+            var += step * (delta * delta - var);
+            stddev[j] = std::clamp(std::sqrt(std::max(var, 0.0f)), kMinStdDb, kMaxStdDb);
+            weight[j] += step * 0.1f * (1.0f - weight[j]);
+        }
+
+        float total = weight[0] + weight[1];
+        weight[0] /= total;
+        weight[1] /= total;
+    }
+};
+
+// In-place iterative radix-2 FFT (size must be a power of two)
+void fft(std::vector<std::complex<float>>& a) {
+    size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(a[i], a[j]);
+        }
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1) {
+        float angle = static_cast<float>(-2.0 * M_PI / static_cast<double>(len));
+        std::complex<float> wlen(std::cos(angle), std::sin(angle));
+        for (size_t i = 0; i < n; i += len) {
+            std::complex<float> w(1.0f, 0.0f);
+            for (size_t k = 0; k < len / 2; ++k) {
+                std::complex<float> u = a[i + k];
+                std::complex<float> v = a[i + k + len / 2] * w;
+                a[i + k] = u + v;
+                a[i + k + len / 2] = u - v;
+                w *= wlen;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+WebRTCVAD::WebRTCVAD(const WebRTCVADOptions& options)
+    : options_(options)
+{
+    if (options_.frame_duration_ms != 10 && options_.frame_duration_ms != 20 &&
+        options_.frame_duration_ms != 30) {
+        std::cerr << "[WebRTCVAD] Frame duration " << options_.frame_duration_ms
+                  << "ms not supported (10/20/30), using 30ms\n";
+        options_.frame_duration_ms = 30;
+    }
+    options_.aggressiveness = std::clamp(options_.aggressiveness, 0, 3);
+}
+
+std::vector<bool> WebRTCVAD::classify_frames(const std::vector<float>& samples, int sample_rate) {
+    size_t frame_len = static_cast<size_t>(sample_rate) * options_.frame_duration_ms / 1000;
+    size_t n_frames = frame_len > 0 ? samples.size() / frame_len : 0;
+    if (n_frames == 0) {
+        return {};
+    }
+
+    size_t fft_size = 1;
+    while (fft_size < frame_len) {
+        fft_size <<= 1;
+    }
+
+    // Hann window, normalised so a full-scale sine sits near 0 dB
+    std::vector<float> window(frame_len);
+    float window_sum = 0.0f;
+    for (size_t i = 0; i < frame_len; ++i) {
+        window[i] = 0.5f * (1.0f - std::cos(2.0f * static_cast<float>(M_PI) * i / (frame_len - 1)));
+        window_sum += window[i];
+    }
+    float power_norm = 4.0f / (window_sum * window_sum);
+
+    // FFT bin range [lo, hi) of each band
+    int band_lo[kNumBands];
+    int band_hi[kNumBands];
+    for (int b = 0; b < kNumBands; ++b) {
+        band_lo[b] = static_cast<int>(std::ceil(kBandEdgesHz[b] * fft_size / sample_rate));
+        band_hi[b] = std::min(static_cast<int>(std::ceil(kBandEdgesHz[b + 1] * fft_size / sample_rate)),
+                              static_cast<int>(fft_size / 2 + 1));
+        band_hi[b] = std::max(band_hi[b], band_lo[b] + 1);
+    }
+
+    // ─── Pass 1: sub-band log energies for every frame ───
+    std::vector<float> features(n_frames * kNumBands);
+    std::vector<float> total_db(n_frames);
+    std::vector<std::complex<float>> spectrum(fft_size);
+
+    for (size_t f = 0; f < n_frames; ++f) {
+        const float* frame = samples.data() + f * frame_len;
+        for (size_t i = 0; i < frame_len; ++i) {
+            spectrum[i] = std::complex<float>(frame[i] * window[i], 0.0f);
+        }
+        std::fill(spectrum.begin() + frame_len, spectrum.end(), std::complex<float>(0.0f, 0.0f));
+        fft(spectrum);
+
+        float total = 0.0f;
+        for (int b = 0; b < kNumBands; ++b) {
+            float energy = 0.0f;
+            for (int k = band_lo[b]; k < band_hi[b]; ++k) {
+                energy += std::norm(spectrum[k]);
+            }
+            energy *= power_norm;
+            total += energy;
+            features[f * kNumBands + b] = 10.0f * std::log10(energy + 1e-12f);
+        }
+        total_db[f] = 10.0f * std::log10(total + 1e-12f);
+    }
+
+    // ─── Initial noise floor: 10th percentile of the opening frames ───
+    // Only frames above kMinEnergyDb count: pass 2 skips the rest, and a gated or
+    // digitally silent opening would otherwise put the floor near -120 dB
+    size_t frames_per_second = 1000 / options_.frame_duration_ms;
+    size_t init_frames = std::min(n_frames, static_cast<size_t>(kInitWindowS * frames_per_second));
+
+    std::vector<size_t> init_indices;
+    init_indices.reserve(init_frames);
+    for (size_t f = 0; f < n_frames && init_indices.size() < init_frames; ++f) {
+        if (total_db[f] >= kMinEnergyDb) {
+            init_indices.push_back(f);
+        }
+    }
+    if (init_indices.empty()) {
+        for (size_t f = 0; f < init_frames; ++f) {
+            init_indices.push_back(f);  // Silent throughout: nothing better to go on
+        }
+    }
+
+    BandGMM noise[kNumBands];
+    BandGMM speech[kNumBands];
+    std::vector<float> column(init_indices.size());
+
+    for (int b = 0; b < kNumBands; ++b) {
+        for (size_t i = 0; i < init_indices.size(); ++i) {
+            column[i] = features[init_indices[i] * kNumBands + b];
+        }
+        auto nth = column.begin() + column.size() / 10;
+        std::nth_element(column.begin(), nth, column.end());
+        float floor_db = *nth;
+
+        noise[b] = {{floor_db, floor_db + 5.0f}, {3.0f, 5.0f}, {0.6f, 0.4f}};
+        speech[b] = {{floor_db + 15.0f, floor_db + 30.0f}, {6.0f, 10.0f}, {0.5f, 0.5f}};
+    }
+
+    // ─── Pass 2: online LLR decisions with model adaptation ───
+    const float global_threshold = kGlobalThreshold[options_.aggressiveness];
+    const float local_threshold = kLocalThreshold[options_.aggressiveness];
+    float weight_sum = 0.0f;
+    for (float w : kBandWeights) {
+        weight_sum += w;
+    }
+
+    // Sliding-window minimum per band (monotonic deque of frame indices)
+    size_t minimum_window = static_cast<size_t>(kMinimumWindowS * frames_per_second);
+    std::deque<size_t> minimum[kNumBands];
+
+    std::vector<bool> decisions(n_frames, false);
+
+    for (size_t f = 0; f < n_frames; ++f) {
+        const float* feat = features.data() + f * kNumBands;
+
+        if (total_db[f] < kMinEnergyDb) {
+            continue;  // Digital silence / gated - no decision, no adaptation
+        }
+
+        float weighted_llr = 0.0f;
+        bool local_hit = false;
+        for (int b = 0; b < kNumBands; ++b) {
+            float llr = speech[b].log_likelihood(feat[b]) - noise[b].log_likelihood(feat[b]);
+            weighted_llr += kBandWeights[b] * llr;
+            local_hit = local_hit || llr > local_threshold;
+        }
+        weighted_llr /= weight_sum;
+
+        bool is_speech = weighted_llr > global_threshold || local_hit;
+        decisions[f] = is_speech;
+
+        for (int b = 0; b < kNumBands; ++b) {
+            // Track the band minimum over the last kMinimumWindowS
+            auto& dq = minimum[b];
+            while (!dq.empty() && features[dq.back() * kNumBands + b] >= feat[b]) {
+                dq.pop_back();
+            }
+            dq.push_back(f);
+            while (dq.front() + minimum_window <= f) {
+                dq.pop_front();
+            }
+            float floor_db = features[dq.front() * kNumBands + b];
+
+            if (is_speech) {
+                speech[b].update(feat[b], kSpeechUpdateRate);
+            } else {
+                noise[b].update(feat[b], kNoiseUpdateRate);
+            }
+
+            // Keep the noise model anchored to the tracked noise floor
+            float noise_mean = noise[b].global_mean();
+            float pull = kBackEta * (floor_db - noise_mean);
+            noise[b].mean[0] += pull;
+            noise[b].mean[1] += pull;
+            noise_mean += pull;
+
+            // Keep speech separated from noise so the models cannot swap
+            for (int j = 0; j < kNumGaussians; ++j) {
+                speech[b].mean[j] = std::max(speech[b].mean[j], noise_mean + kMinSpeechGapDb);
+            }
+        }
+    }
+
+    return decisions;
+}
+
+std::vector<SpeechSegment> WebRTCVAD::detect_speech(
+    const std::vector<float>& samples,
+    int sample_rate
+) {
+    std::vector<SpeechSegment> segments;
+
+    if (samples.empty()) return segments;
+
+    if (sample_rate < 8000) {
+        std::cerr << "[WebRTCVAD] Warning: Sample rate " << sample_rate
+                  << " too low, need at least 8000\n";
+        return segments;
+    }
+
+    std::vector<bool> decisions = classify_frames(samples, sample_rate);
+    float frame_s = options_.frame_duration_ms / 1000.0f;
+    float audio_duration = static_cast<float>(samples.size()) / sample_rate;
+
+    // Runs of speech frames -> raw segments
+    size_t run_start = 0;
+    bool in_speech = false;
+    for (size_t f = 0; f <= decisions.size(); ++f) {
+        bool is_speech = f < decisions.size() && decisions[f];
+        if (is_speech && !in_speech) {
+            run_start = f;
+            in_speech = true;
+        } else if (!is_speech && in_speech) {
+            segments.emplace_back(run_start * frame_s, std::min(audio_duration, f * frame_s));
+            in_speech = false;
+        }
+    }
+
+    segments = post_process_segments(segments, audio_duration);
+
+    std::cout << "[WebRTCVAD] Detected " << segments.size() << " speech segments (mode "
+              << options_.aggressiveness << ", " << options_.frame_duration_ms << "ms frames)\n";
+    return segments;
+}
+
+std::vector<SpeechSegment> WebRTCVAD::post_process_segments(
+    const std::vector<SpeechSegment>& segments,
+    float audio_duration
+) {
+    if (segments.empty()) return segments;
+
+    float min_speech_sec = options_.min_speech_duration_ms / 1000.0f;
+    float min_silence_sec = options_.min_silence_duration_ms / 1000.0f;
+    float pad_sec = options_.speech_pad_ms / 1000.0f;
+
+    std::vector<SpeechSegment> merged;
+    SpeechSegment current = segments[0];
+
+    // Merge segments that are close together
+    for (size_t i = 1; i < segments.size(); ++i) {
+        float gap = segments[i].start - current.end;
+
+        if (gap < min_silence_sec) {
+            current.end = segments[i].end;
+        } else {
+            merged.push_back(current);
+            current = segments[i];
+        }
+    }
+    merged.push_back(current);
+
+    // Filter short segments and add padding
+    std::vector<SpeechSegment> result;
+    for (auto& seg : merged) {
+        if (seg.end - seg.start >= min_speech_sec) {
+            seg.start = std::max(0.0f, seg.start - pad_sec);
+            seg.end = std::min(audio_duration, seg.end + pad_sec);
+            result.push_back(seg);
+        }
+    }
+
+    return result;
+}
+
+SpeechView WebRTCVAD::speech_view(
+    const std::vector<float>& samples,
+    int sample_rate,
+    std::vector<SpeechSegment>& segments
+) {
+    segments = detect_speech(samples, sample_rate);
+
+    if (segments.empty()) {
+        // Check if truly silent
+        float max_sample = 0.0f;
+        for (size_t i = 0; i < samples.size(); i += 100) {
+            max_sample = std::max(max_sample, std::abs(samples[i]));
+        }
+
+        if (max_sample < 0.001f) {
+            std::cout << "[WebRTCVAD] Track is silent - skipping\n";
+            silence_removed_ = static_cast<float>(samples.size()) / sample_rate;
+            return {};
+        }
+
+        std::cout << "[WebRTCVAD] No speech detected - returning original audio\n";
+        silence_removed_ = 0.0f;
+        return SpeechView(samples.data(), samples.size(), sample_rate);
+    }
+
+    float total_duration = static_cast<float>(samples.size()) / sample_rate;
+    float speech_duration = 0.0f;
+
+    for (const auto& seg : segments) {
+        speech_duration += seg.end - seg.start;
+    }
+
+    silence_removed_ = total_duration - speech_duration;
+
+    std::cout << "[WebRTCVAD] Removed " << silence_removed_ << "s silence ("
+              << static_cast<int>(silence_removed_ / total_duration * 100) << "%)\n";
+
+    return SpeechView(samples.data(), samples.size(), segments, sample_rate);
+}
+
+std::vector<float> WebRTCVAD::filter_silence(
+    const std::vector<float>& samples,
+    int sample_rate,
+    std::vector<SpeechSegment>& segments
+) {
+    return speech_view(samples, sample_rate, segments).to_vector();
+}
+
+} // namespace muninn
@@ -0,0 +1,333 @@
+/**
+ * @file bench_diarization.cpp
+ * @brief Benchmark: diarization throughput, clustering scaling and accuracy
+ *
+ * Runs entirely on the CPU without model files. A deterministic synthetic
+ * conversation (each speaker a fixed set of tones plus noise, with known
+ * turns) is diarized through a mock EmbeddingBackend that measures tone
+ * energies with the Goertzel algorithm. Reports:
+ *   - embedding extraction rate (windows/sec through the batched pipeline)
+ *   - clustering time versus number of embeddings (AHC and two-stage)
+ *   - diarization error rate (DER) against the known turns
+ *
+ * Usage: bench_diarization [minutes] [speakers]
+ */
+
+#include "muninn/diarization.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+
+namespace {
+
+constexpr int kSampleRate = 16000;
+constexpr size_t kToneCount = 64;          // Candidate tone frequencies (= embedding dim)
+constexpr float kToneBaseHz = 100.0f;
+constexpr float kToneStepHz = 50.0f;
+constexpr size_t kTonesPerSpeaker = 4;
+
+float tone_frequency(size_t index) {
+    return kToneBaseHz + kToneStepHz * static_cast<float>(index);
+}
+
+/**
+ * @brief Mock embedding model: tone energies at the kToneCount frequencies
+ *
+ * Deterministic and stateless (safe for concurrent embed() calls).
+ */
+class ToneEmbeddingBackend : public muninn::EmbeddingBackend {
+public:
+    size_t input_samples() const override { return kSampleRate; }
+    size_t dim() const override { return kToneCount; }
+
+    void embed(const float* const* windows, const size_t* lengths,
+               size_t count, float* output) override {
+        for (size_t w = 0; w < count; ++w) {
+            const float* x = windows[w];
+            const size_t n = std::min(lengths[w], input_samples());
+            float* row = output + w * kToneCount;
+
+            for (size_t t = 0; t < kToneCount; ++t) {
+                // Goertzel power at the tone frequency
+                const float coeff = 2.0f * std::cos(2.0f * static_cast<float>(M_PI) *
+                                                    tone_frequency(t) / kSampleRate);
+                float s1 = 0.0f, s2 = 0.0f;
+                for (size_t i = 0; i < n; ++i) {
+                    float s0 = x[i] + coeff * s1 - s2;
+                    s2 = s1;
+                    s1 = s0;
+                }
+                float power = s1 * s1 + s2 * s2 - coeff * s1 * s2;
+                row[t] = std::sqrt(std::max(0.0f, power)) / static_cast<float>(std::max<size_t>(n, 1));
+            }
+        }
+    }
+};
+
+struct Turn {
+    float start;
+    float end;
+    int speaker;
+};
+
+/**
+ * @brief Synthetic conversation with known speaker turns
+ */
+struct Conversation {
+    std::vector<float> audio;
+    std::vector<Turn> turns;
+};
+
+Conversation make_conversation(float minutes, int num_speakers, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> turn_length(1.5f, 6.0f);
+    std::uniform_real_distribution<float> pause_length(0.1f, 0.6f);
+    std::uniform_real_distribution<float> amplitude(0.3f, 1.0f);
+    std::uniform_real_distribution<float> jitter(0.8f, 1.2f);
+    std::normal_distribution<float> noise(0.0f, 0.02f);
+
+    // Each speaker: kTonesPerSpeaker distinct tones with fixed amplitudes
+    std::vector<size_t> tone_pool(kToneCount);
+    for (size_t i = 0; i < kToneCount; ++i) {
+        tone_pool[i] = i;
+    }
+    std::shuffle(tone_pool.begin(), tone_pool.end(), rng);
+
+    std::vector<std::vector<std::pair<float, float>>> voices(num_speakers);
+    for (int s = 0; s < num_speakers; ++s) {
+        for (size_t k = 0; k < kTonesPerSpeaker; ++k) {
+            size_t tone = tone_pool[(s * kTonesPerSpeaker + k) % kToneCount];
+            voices[s].push_back({tone_frequency(tone), amplitude(rng)});
+        }
+    }
+
+    Conversation conv;
+    const size_t total = static_cast<size_t>(minutes * 60.0f * kSampleRate);
+    conv.audio.reserve(total);
+
+    int speaker = 0;
+    std::uniform_int_distribution<int> next_speaker(1, std::max(1, num_speakers - 1));
+
+    while (conv.audio.size() < total) {
+        // Pause (background noise only)
+        size_t pause = static_cast<size_t>(pause_length(rng) * kSampleRate);
+        for (size_t i = 0; i < pause && conv.audio.size() < total; ++i) {
+            conv.audio.push_back(noise(rng));
+        }
+
+        // Turn
+        size_t begin = conv.audio.size();
+        size_t length = std::min(static_cast<size_t>(turn_length(rng) * kSampleRate), total - begin);
+        float gain = jitter(rng);
+        for (size_t i = 0; i < length; ++i) {
+            float t = static_cast<float>(begin + i) / kSampleRate;
+            float sample = noise(rng);
+            for (const auto& [freq, amp] : voices[speaker]) {
+                sample += 0.1f * gain * amp * std::sin(2.0f * static_cast<float>(M_PI) * freq * t);
+            }
+            conv.audio.push_back(sample);
+        }
+        if (length > 0) {
+            conv.turns.push_back({static_cast<float>(begin) / kSampleRate,
+                                  static_cast<float>(begin + length) / kSampleRate, speaker});
+        }
+
+        if (num_speakers > 1) {
+            speaker = (speaker + next_speaker(rng)) % num_speakers;
+        }
+    }
+
+    return conv;
+}
+
+/**
+ * @brief Frame-level diarization error rate (10ms frames, no collar)
+ *
+ * Hypothesis speakers are mapped to reference speakers greedily by largest
+ * overlap. DER = (missed + false alarm + confusion) / reference speech.
+ */
+float diarization_error_rate(const std::vector<Turn>& reference,
+                             const std::vector<muninn::DiarizationSegment>& hypothesis,
+                             float duration) {
+    constexpr float kFrame = 0.01f;
+    const size_t frames = static_cast<size_t>(duration / kFrame) + 1;
+
+    std::vector<int> ref(frames, -1), hyp(frames, -1);
+    for (const auto& turn : reference) {
+        for (size_t f = static_cast<size_t>(turn.start / kFrame); f < frames && f * kFrame < turn.end; ++f) {
+            ref[f] = turn.speaker;
+        }
+    }
+    for (const auto& seg : hypothesis) {
+        for (size_t f = static_cast<size_t>(seg.start / kFrame); f < frames && f * kFrame < seg.end; ++f) {
+            hyp[f] = seg.speaker_id;
+        }
+    }
+
+    // Greedy one-to-one speaker mapping by co-occurrence
+    std::map<std::pair<int, int>, size_t> overlap;
+    for (size_t f = 0; f < frames; ++f) {
+        if (ref[f] >= 0 && hyp[f] >= 0) {
+            ++overlap[{hyp[f], ref[f]}];
+        }
+    }
+    std::vector<std::pair<size_t, std::pair<int, int>>> pairs;
+    for (const auto& [key, count] : overlap) {
+        pairs.push_back({count, key});
+    }
+    std::sort(pairs.rbegin(), pairs.rend());
+
+    std::map<int, int> mapping;
+    std::set<int> used_ref;
+    for (const auto& [count, key] : pairs) {
+        if (mapping.count(key.first) == 0 && used_ref.count(key.second) == 0) {
+            mapping[key.first] = key.second;
+            used_ref.insert(key.second);
+        }
+    }
+
+    size_t speech = 0, errors = 0;
+    for (size_t f = 0; f < frames; ++f) {
+        if (ref[f] >= 0) {
+            ++speech;
+        }
+        if (ref[f] < 0 && hyp[f] < 0) {
+            continue;
+        }
+        if (ref[f] < 0 || hyp[f] < 0) {
+            ++errors;                                   // False alarm / missed speech
+        } else {
+            auto it = mapping.find(hyp[f]);
+            if (it == mapping.end() || it->second != ref[f]) {
+                ++errors;                               // Speaker confusion
+            }
+        }
+    }
+    return speech > 0 ? static_cast<float>(errors) / speech : 0.0f;
+}
+
+/**
+ * @brief Normalised embeddings around num_clusters random centres
+ */
+muninn::EmbeddingMatrix make_clustered_embeddings(size_t n, size_t dim, int num_clusters, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+
+    std::vector<float> centres(num_clusters * dim);
+    for (auto& v : centres) {
+        v = dist(rng);
+    }
+
+    muninn::EmbeddingMatrix matrix;
+    matrix.dim = dim;
+    matrix.data.resize(n * dim);
+    matrix.starts.resize(n);
+    matrix.ends.resize(n);
+
+    std::uniform_int_distribution<int> pick(0, num_clusters - 1);
+    for (size_t i = 0; i < n; ++i) {
+        const float* centre = centres.data() + pick(rng) * dim;
+        float* row = matrix.row(i);
+        for (size_t d = 0; d < dim; ++d) {
+            row[d] = centre[d] + 0.3f * dist(rng);
+        }
+        matrix.starts[i] = i * 0.5f;
+        matrix.ends[i] = i * 0.5f + 1.0f;
+    }
+    matrix.normalize();
+    return matrix;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    std::cout << "═══════════════════════════════════════════════════════════\n";
+    std::cout << "Muninn Diarization Benchmark\n";
+    std::cout << "═══════════════════════════════════════════════════════════\n\n";
+
+    float minutes = argc > 1 ? static_cast<float>(std::atof(argv[1])) : 10.0f;
+    int num_speakers = argc > 2 ? std::atoi(argv[2]) : 4;
+
+    // Maximum DER on the synthetic conversation for the check to pass
+    const float der_tolerance = 0.10f;
+
+    muninn::DiarizationOptions options;
+    options.max_speakers = std::max(10, num_speakers);
+
+    muninn::Diarizer diarizer(std::make_unique<ToneEmbeddingBackend>(), options);
+
+    // ─── Synthetic conversation ───
+    Conversation conv = make_conversation(minutes, num_speakers, 42);
+    const float duration = static_cast<float>(conv.audio.size()) / kSampleRate;
+
+    std::vector<muninn::SpeechSegment> speech;
+    for (const auto& turn : conv.turns) {
+        speech.emplace_back(turn.start, turn.end);
+    }
+
+    std::cout << "[Bench] Audio:     " << std::fixed << std::setprecision(1) << duration << "s\n";
+    std::cout << "[Bench] Speakers:  " << num_speakers << "\n";
+    std::cout << "[Bench] Turns:     " << conv.turns.size() << "\n\n";
+
+    // ─── Embedding extraction ───
+    auto t0 = std::chrono::high_resolution_clock::now();
+    auto embeddings = diarizer.extract_embedding_matrix(conv.audio.data(), conv.audio.size(), speech, kSampleRate);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double extract_s = std::chrono::duration<double>(t1 - t0).count();
+
+    // ─── Full diarization on the speech timeline ───
+    auto t2 = std::chrono::high_resolution_clock::now();
+    auto result = diarizer.diarize(conv.audio.data(), conv.audio.size(), speech, kSampleRate);
+    auto t3 = std::chrono::high_resolution_clock::now();
+    double diarize_s = std::chrono::duration<double>(t3 - t2).count();
+
+    float der = diarization_error_rate(conv.turns, result.segments, duration);
+
+    // ─── Clustering time versus N (AHC, then two-stage past ahc_max_embeddings) ───
+    std::vector<size_t> sizes = {1000, 2000, 5000, 10000, 20000, 40000};
+    std::vector<std::pair<double, size_t>> clustering;
+    for (size_t n : sizes) {
+        auto matrix = make_clustered_embeddings(n, 256, num_speakers, static_cast<unsigned>(n));
+        auto c0 = std::chrono::high_resolution_clock::now();
+        auto labels = diarizer.cluster_embeddings(matrix);
+        auto c1 = std::chrono::high_resolution_clock::now();
+
+        std::set<int> found(labels.begin(), labels.end());
+        clustering.push_back({std::chrono::duration<double>(c1 - c0).count(), found.size()});
+    }
+
+    std::cout << "\n[Results]\n";
+    std::cout << "    Embeddings:        " << embeddings.rows() << " in " << std::setprecision(3) << extract_s
+              << "s (" << std::setprecision(1) << embeddings.rows() / std::max(extract_s, 1e-9) << " emb/s)\n";
+    std::cout << "    Diarization:       " << std::setprecision(3) << diarize_s << "s ("
+              << std::setprecision(1) << duration / std::max(diarize_s, 1e-9) << "x real-time)\n";
+    std::cout << "    Speakers found:    " << result.num_speakers << " / " << num_speakers << "\n";
+    std::cout << "    DER:               " << std::setprecision(2) << der * 100.0f << "%\n\n";
+
+    std::cout << "    Clustering (dim 256, " << num_speakers << " clusters):\n";
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        std::cout << "      N = " << std::setw(6) << sizes[i] << ":  " << std::setprecision(3)
+                  << std::setw(8) << clustering[i].first << "s  (" << clustering[i].second << " speakers"
+                  << (sizes[i] > static_cast<size_t>(options.ahc_max_embeddings) ? ", two-stage" : "")
+                  << ")\n";
+    }
+    std::cout << "\n";
+
+    bool passed = der <= der_tolerance && static_cast<int>(result.num_speakers) == num_speakers;
+
+    std::cout << "═══════════════════════════════════════════════════════════\n";
+    if (passed) {
+        std::cout << "✓ SUCCESS: synthetic conversation diarized within tolerance\n";
+    } else {
+        std::cout << "✗ FAILED: DER or speaker count outside tolerance\n";
+    }
+    std::cout << "═══════════════════════════════════════════════════════════\n";
+
+    return passed ? 0 : 1;
+}
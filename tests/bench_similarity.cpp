@@ -0,0 +1,102 @@
+/**
+ * @file bench_similarity.cpp
+ * @brief Benchmark: all-pairs speaker-embedding similarity
+ *
+ * Compares the per-pair path (Diarizer::cosine_similarity on separate
+ * SpeakerEmbedding vectors, norms recomputed every call) against the blocked
+ * kernel over one L2-normalised [N, D] matrix, and checks they agree.
+ *
+ * Usage: bench_similarity [num_windows] [dim]
+ */
+
+#include "muninn/diarization.h"
+#include "muninn/embedding_ops.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+int main(int argc, char* argv[]) {
+    std::cout << "═══════════════════════════════════════════════════════════\n";
+    std::cout << "Muninn Embedding Similarity Benchmark\n";
+    std::cout << "═══════════════════════════════════════════════════════════\n\n";
+
+    size_t n = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 10000;
+    size_t dim = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 512;
+
+    // Maximum |difference| between the two paths for the check to pass
+    const float tolerance = 1e-4f;
+
+    // Synthetic embeddings (un-normalised, like raw model output)
+    std::mt19937 rng(42);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+
+    std::vector<muninn::SpeakerEmbedding> embeddings(n);
+    muninn::EmbeddingMatrix matrix;
+    matrix.dim = dim;
+    matrix.data.resize(n * dim);
+    matrix.starts.resize(n);
+    matrix.ends.resize(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        embeddings[i].features.resize(dim);
+        for (size_t k = 0; k < dim; ++k) {
+            embeddings[i].features[k] = dist(rng);
+        }
+        std::copy(embeddings[i].features.begin(), embeddings[i].features.end(), matrix.row(i));
+        matrix.starts[i] = embeddings[i].start = i * 0.5f;
+        matrix.ends[i] = embeddings[i].end = i * 0.5f + 1.0f;
+    }
+
+    std::cout << "[Bench] Windows:  " << n << "\n";
+    std::cout << "[Bench] Dim:      " << dim << "\n";
+    std::cout << "[Bench] Matrix:   " << std::fixed << std::setprecision(1)
+              << (n * n * sizeof(float)) / (1024.0 * 1024.0) << " MB\n\n";
+
+    // ─── Blocked kernel over the normalised matrix ───
+    std::vector<float> similarity(n * n);
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    matrix.normalize();
+    muninn::EmbeddingOps::similarity_matrix(matrix.data.data(), n, dim, similarity.data());
+    auto t1 = std::chrono::high_resolution_clock::now();
+    double blocked_s = std::chrono::duration<double>(t1 - t0).count();
+
+    // ─── Per-pair reference (upper triangle, like the old clustering loops) ───
+    float max_diff = 0.0f;
+    auto t2 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) {
+            float ref = muninn::Diarizer::cosine_similarity(embeddings[i], embeddings[j]);
+            max_diff = std::max(max_diff, std::abs(ref - similarity[i * n + j]));
+        }
+    }
+    auto t3 = std::chrono::high_resolution_clock::now();
+    double pairwise_s = std::chrono::duration<double>(t3 - t2).count();
+
+    // Useful work: N^2/2 dot products of length D (2 flops per element)
+    double flops = static_cast<double>(n) * n * dim;
+
+    std::cout << "[Results]\n";
+    std::cout << "    Per-pair cosine:   " << std::setprecision(3) << pairwise_s << "s ("
+              << std::setprecision(2) << flops / pairwise_s * 1e-9 << " GFLOP/s)\n";
+    std::cout << "    Blocked kernel:    " << std::setprecision(3) << blocked_s << "s ("
+              << std::setprecision(2) << flops / blocked_s * 1e-9 << " GFLOP/s)\n";
+    std::cout << "    Speedup:           " << (blocked_s > 0.0 ? pairwise_s / blocked_s : 0.0) << "x\n";
+    std::cout << "    Max difference:    " << std::scientific << max_diff << std::fixed << "\n\n";
+
+    bool passed = max_diff <= tolerance;
+
+    std::cout << "═══════════════════════════════════════════════════════════\n";
+    if (passed) {
+        std::cout << "✓ SUCCESS: blocked kernel matches per-pair cosine similarity\n";
+    } else {
+        std::cout << "✗ FAILED: blocked kernel deviates from per-pair cosine similarity\n";
+    }
+    std::cout << "═══════════════════════════════════════════════════════════\n";
+
+    return passed ? 0 : 1;
+}
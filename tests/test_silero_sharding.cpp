@@ -0,0 +1,168 @@
+/**
+ * @file test_silero_sharding.cpp
+ * @brief Accuracy and speed check: sharded Silero VAD vs sequential run
+ *
+ * Runs Silero VAD over one track sequentially (exact LSTM state) and with
+ * N parallel shards, then compares per-window probabilities, speech/non-speech
+ * decisions and the resulting speech timeline (IoU).
+ *
+ * Usage: test_silero_sharding <audio_file> <silero_vad.onnx> [num_shards] [warmup_s]
+ */
+
+#include "muninn/audio_extractor.h"
+#include "muninn/silero_vad.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+// Total seconds covered by segments (segments are sorted and disjoint)
+float covered_duration(const std::vector<muninn::SpeechSegment>& segments) {
+    float total = 0.0f;
+    for (const auto& seg : segments) {
+        total += seg.end - seg.start;
+    }
+    return total;
+}
+
+// Intersection of two sorted segment lists (two-pointer sweep)
+float intersection_duration(const std::vector<muninn::SpeechSegment>& a,
+                            const std::vector<muninn::SpeechSegment>& b) {
+    float total = 0.0f;
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        float start = std::max(a[i].start, b[j].start);
+        float end = std::min(a[i].end, b[j].end);
+        if (end > start) {
+            total += end - start;
+        }
+        if (a[i].end < b[j].end) {
+            ++i;
+        } else {
+            ++j;
+        }
+    }
+    return total;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    std::cout << "═══════════════════════════════════════════════════════════\n";
+    std::cout << "Muninn Sharded Silero VAD Test\n";
+    std::cout << "═══════════════════════════════════════════════════════════\n\n";
+
+    if (argc < 3) {
+        std::cout << "Usage: " << argv[0] << " <audio_file> <silero_vad.onnx> [num_shards] [warmup_s]\n";
+        std::cout << "\nExample:\n";
+        std::cout << "  " << argv[0] << " podcast.mp3 models/silero_vad.onnx 8 2.0\n";
+        return 1;
+    }
+
+    std::string file_path = argv[1];
+    std::string model_path = argv[2];
+    int num_shards = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+    float warmup_s = argc > 4 ? static_cast<float>(std::atof(argv[4])) : 2.0f;
+    num_shards = std::max(2, num_shards);
+
+    // Minimum speech-timeline IoU for the check to pass
+    const float min_iou = 0.98f;
+
+    try {
+        muninn::AudioExtractor extractor;
+        if (!extractor.open(file_path)) {
+            std::cerr << "[ERROR] Failed to open file: " << extractor.get_last_error() << "\n";
+            return 1;
+        }
+
+        std::vector<float> samples;
+        if (!extractor.extract_track(0, samples)) {
+            std::cerr << "[ERROR] Failed to extract track: " << extractor.get_last_error() << "\n";
+            return 1;
+        }
+        extractor.close();
+
+        float duration = samples.size() / 16000.0f;
+        std::cout << "[Test] File:     " << file_path << " (" << std::fixed << std::setprecision(1)
+                  << duration << "s)\n";
+        std::cout << "[Test] Shards:   " << num_shards << ", warm-up " << warmup_s << "s\n\n";
+
+        muninn::SileroVADOptions options;
+        options.model_path = model_path;
+        options.min_shard_duration_s = 0.0f;  // Shard regardless of length for the comparison
+
+        // Sequential reference
+        options.num_shards = 1;
+        muninn::SileroVAD sequential(options);
+
+        auto t0 = std::chrono::high_resolution_clock::now();
+        auto seq_probs = sequential.speech_probabilities(samples);
+        auto seq_segments = sequential.detect_speech(samples, 16000);
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        // Sharded
+        options.num_shards = num_shards;
+        options.shard_warmup_s = warmup_s;
+        muninn::SileroVAD sharded(options);
+
+        auto t2 = std::chrono::high_resolution_clock::now();
+        auto shard_probs = sharded.speech_probabilities(samples);
+        auto shard_segments = sharded.detect_speech(samples, 16000);
+        auto t3 = std::chrono::high_resolution_clock::now();
+
+        // Both runs include probabilities + detection, so the ratio is fair
+        double seq_s = std::chrono::duration<double>(t1 - t0).count();
+        double shard_s = std::chrono::duration<double>(t3 - t2).count();
+
+        // Per-window comparison
+        float max_diff = 0.0f;
+        size_t flipped = 0;
+        size_t n = std::min(seq_probs.size(), shard_probs.size());
+        for (size_t i = 0; i < n; ++i) {
+            max_diff = std::max(max_diff, std::abs(seq_probs[i] - shard_probs[i]));
+            if ((seq_probs[i] >= options.threshold) != (shard_probs[i] >= options.threshold)) {
+                ++flipped;
+            }
+        }
+
+        // Speech timeline agreement
+        float seq_speech = covered_duration(seq_segments);
+        float shard_speech = covered_duration(shard_segments);
+        float inter = intersection_duration(seq_segments, shard_segments);
+        float uni = seq_speech + shard_speech - inter;
+        float iou = uni > 0.0f ? inter / uni : 1.0f;
+
+        std::cout << "[Results]\n";
+        std::cout << "    Sequential:        " << std::setprecision(2) << seq_s << "s, "
+                  << seq_segments.size() << " segments, " << seq_speech << "s speech\n";
+        std::cout << "    Sharded:           " << shard_s << "s, "
+                  << shard_segments.size() << " segments, " << shard_speech << "s speech\n";
+        std::cout << "    Speedup:           " << (shard_s > 0.0 ? seq_s / shard_s : 0.0) << "x\n";
+        std::cout << "    Windows:           " << n << (seq_probs.size() == shard_probs.size() ? "" : " (COUNT MISMATCH)") << "\n";
+        std::cout << "    Max prob diff:     " << std::setprecision(4) << max_diff << "\n";
+        std::cout << "    Flipped decisions: " << flipped << " ("
+                  << (n > 0 ? 100.0 * flipped / n : 0.0) << "%)\n";
+        std::cout << "    Speech IoU:        " << iou << "\n\n";
+
+        bool passed = seq_probs.size() == shard_probs.size() && iou >= min_iou;
+
+        std::cout << "═══════════════════════════════════════════════════════════\n";
+        if (passed) {
+            std::cout << "✓ SUCCESS: sharded VAD matches sequential run (IoU >= " << min_iou << ")\n";
+        } else {
+            std::cout << "✗ FAILED: sharded VAD deviates from sequential run (IoU < " << min_iou << ")\n";
+        }
+        std::cout << "═══════════════════════════════════════════════════════════\n";
+
+        return passed ? 0 : 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n[EXCEPTION] " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,171 @@
+/**
+ * @file test_translation_batching.cpp
+ * @brief Unit checks for translation batching: batch planning, dedup and fan-out
+ *
+ * Needs no model files: inputs are dummy token lists of known lengths, and
+ * translations are filled in the way Translator does after a model call.
+ *
+ * Usage: test_translation_batching
+ */
+
+#include "translation/batching.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "    [OK]   " : "    [FAIL] ") << what << "\n";
+    if (!condition) {
+        ++g_failures;
+    }
+}
+
+// One dummy source per length
+std::vector<std::vector<std::string>> sources_of(const std::vector<size_t>& lengths) {
+    std::vector<std::vector<std::string>> sources;
+    for (size_t length : lengths) {
+        sources.emplace_back(length, "tok");
+    }
+    return sources;
+}
+
+// Every input index appears in exactly one batch
+bool is_partition(const std::vector<std::vector<size_t>>& batches, size_t count) {
+    std::vector<int> seen(count, 0);
+    for (const auto& batch : batches) {
+        for (size_t index : batch) {
+            if (index >= count || seen[index]++ > 0) {
+                return false;
+            }
+        }
+    }
+    for (int s : seen) {
+        if (s != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<size_t> batch_sizes(const std::vector<std::vector<size_t>>& batches) {
+    std::vector<size_t> sizes;
+    for (const auto& batch : batches) {
+        sizes.push_back(batch.size());
+    }
+    return sizes;
+}
+
+} // anonymous namespace
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════\n";
+    std::cout << "Muninn Translation Batching Test\n";
+    std::cout << "═══════════════════════════════════════════════════════════\n\n";
+
+    using muninn::translation::plan_batches;
+    using Batches = std::vector<std::vector<size_t>>;
+
+    std::cout << "[Token budget]\n";
+    {
+        muninn::TranslationOptions options;
+        options.max_batch_size = 12;
+
+        auto batches = plan_batches(sources_of({3, 3, 3, 3}), options);
+        check(batches == Batches{{0, 1, 2, 3}}, "4 x 3 padded tokens fill a budget of 12 exactly");
+
+        batches = plan_batches(sources_of({3, 3, 3, 3, 3}), options);
+        check(batches == Batches{{0, 1, 2, 3}, {4}}, "a fifth input starts a new batch");
+
+        // Padding counts: 2 + 2 fit, but a 5 would make it 3 x 5 = 15
+        batches = plan_batches(sources_of({2, 2, 5}), options);
+        check(batches == Batches{{0, 1}, {2}}, "cost is longest x count, not the token sum");
+    }
+
+    std::cout << "[Input order]\n";
+    {
+        muninn::TranslationOptions options;
+        options.max_batch_size = 8;
+        std::vector<size_t> lengths = {5, 1, 3, 2, 4, 1};
+
+        auto batches = plan_batches(sources_of(lengths), options);
+        check(is_partition(batches, lengths.size()), "every input planned exactly once");
+        check(batches == Batches{{1, 5, 3}, {2, 4}, {0}}, "shortest first, ties keep input order");
+
+        bool ascending = true;
+        size_t previous = 0;
+        for (const auto& batch : batches) {
+            for (size_t index : batch) {
+                ascending = ascending && lengths[index] >= previous;
+                previous = lengths[index];
+            }
+        }
+        check(ascending, "indices map back to inputs in length order");
+
+        options.sort_by_length = false;
+        batches = plan_batches(sources_of(lengths), options);
+        check(batches == Batches{{0}, {1, 2}, {3, 4}, {5}}, "sort_by_length off keeps input order");
+    }
+
+    std::cout << "[Oversized input]\n";
+    {
+        muninn::TranslationOptions options;
+        options.max_batch_size = 12;
+
+        auto batches = plan_batches(sources_of({2, 50, 2}), options);
+        check(batches == Batches{{0, 2}, {1}}, "input over the budget gets its own batch");
+
+        batches = plan_batches(sources_of({50}), options);
+        check(batches == Batches{{0}}, "single oversized input is still planned");
+    }
+
+    std::cout << "[Unbounded and examples]\n";
+    {
+        muninn::TranslationOptions options;
+        options.max_batch_size = 0;
+        auto batches = plan_batches(sources_of({40, 1, 300, 7}), options);
+        check(batches == Batches{{1, 3, 0, 2}}, "max_batch_size 0 plans a single batch");
+
+        options.max_batch_size = 2;
+        options.batch_type = "examples";
+        batches = plan_batches(sources_of({40, 1, 300, 7, 9}), options);
+        check(batch_sizes(batches) == std::vector<size_t>{2, 2, 1}, "examples budget counts inputs");
+
+        check(plan_batches({}, options).empty(), "no inputs, no batches");
+    }
+
+    std::cout << "[Dedup]\n";
+    {
+        std::vector<std::string> texts = {"Thank you", "  Thank   you ", "hello", "thank you", "Thank you"};
+        auto plan = muninn::translation::dedup_texts(texts);
+
+        check(plan.first == std::vector<size_t>{0, 2, 3}, "one entry per distinct text, first occurrence kept");
+        check(plan.slot == std::vector<size_t>{0, 0, 1, 2, 0}, "whitespace variants share a slot, case does not");
+        check(plan.keys.size() == 3 && plan.keys[0] == "Thank you" && plan.keys[1] == "hello",
+              "keys are the normalised texts");
+        check(muninn::translation::dedup_texts({}).first.empty(), "no texts, no entries");
+    }
+
+    std::cout << "[Fan-out]\n";
+    {
+        std::vector<std::string> texts = {"yes", "no", "yes", "maybe", "no", "yes"};
+        auto plan = muninn::translation::dedup_texts(texts);
+
+        // Two targets answered from one dedup plan; "maybe" failed for French
+        std::vector<std::string> spanish = texts;
+        muninn::translation::fan_out(plan, {"sí", "no", "quizás"}, {true, true, true}, spanish);
+        check(spanish == std::vector<std::string>{"sí", "no", "sí", "quizás", "no", "sí"},
+              "every occurrence gets its translation");
+
+        std::vector<std::string> french = texts;
+        muninn::translation::fan_out(plan, {"oui", "non", ""}, {true, true, false}, french);
+        check(french == std::vector<std::string>{"oui", "non", "oui", "maybe", "non", "oui"},
+              "untranslated text keeps the original, per target");
+    }
+
+    std::cout << "\n" << (g_failures == 0 ? "[PASS]" : "[FAIL]") << " " << g_failures << " failure(s)\n";
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file test_translation_cache.cpp
+ * @brief Unit checks for TranslationCache: lookup, LRU eviction, persistence
+ *
+ * Needs no model files: entries are inserted directly, the way Translator
+ * does after a model call.
+ *
+ * Usage: test_translation_cache [scratch_dir]
+ */
+
+#include "muninn/translation_cache.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+int g_failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "    [OK]   " : "    [FAIL] ") << what << "\n";
+    if (!condition) {
+        ++g_failures;
+    }
+}
+
+bool has(muninn::TranslationCache& cache, const std::string& text, const std::string& expected = "") {
+    std::string translation;
+    bool hit = cache.lookup("en", "es", 0, text, translation);
+    return hit && (expected.empty() || translation == expected);
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    std::cout << "═══════════════════════════════════════════════════════════\n";
+    std::cout << "Muninn Translation Cache Test\n";
+    std::cout << "═══════════════════════════════════════════════════════════\n\n";
+
+    fs::path scratch = argc > 1 ? fs::path(argv[1]) : fs::temp_directory_path();
+    fs::path persist = scratch / "muninn_test_translation_cache.bin";
+    fs::remove(persist);
+
+    using muninn::TranslationCache;
+
+    std::cout << "[Normalize]\n";
+    check(TranslationCache::normalize("  Thank \t you!\n") == "Thank you!", "whitespace collapsed and trimmed");
+    check(TranslationCache::normalize("Thank you") != TranslationCache::normalize("thank you"), "case kept");
+
+    std::cout << "[Options hash]\n";
+    muninn::TranslationOptions a;
+    muninn::TranslationOptions b = a;
+    b.max_batch_size = a.max_batch_size + 64;
+    check(TranslationCache::options_hash(a) == TranslationCache::options_hash(b), "batching options ignored");
+    b = a;
+    b.beam_size = a.beam_size + 1;
+    check(TranslationCache::options_hash(a) != TranslationCache::options_hash(b), "beam size changes the hash");
+    check(TranslationCache::options_hash(a, "models/nllb-200-distilled-600M") !=
+          TranslationCache::options_hash(a, "models/nllb-200-1.3B"), "model changes the hash");
+
+    std::cout << "[Lookup]\n";
+    {
+        TranslationCache cache;
+        cache.insert("en", "es", 0, "hello", "hola");
+        check(has(cache, "hello", "hola"), "hit after insert");
+        check(!has(cache, "goodbye"), "miss for unknown text");
+
+        std::string translation;
+        check(!cache.lookup("en", "fr", 0, "hello", translation), "target language is part of the key");
+        check(!cache.lookup("en", "es", 1, "hello", translation), "options hash is part of the key");
+
+        auto stats = cache.stats();
+        check(stats.hits == 1 && stats.misses == 3, "hit/miss counters");
+        check(stats.entries == 1 && stats.bytes > 0, "occupancy");
+    }
+
+    std::cout << "[LRU eviction]\n";
+    {
+        // Room for three entries of this size, not four
+        TranslationCache probe;
+        probe.insert("en", "es", 0, "text-0", "translation-0");
+        size_t entry_bytes = probe.stats().bytes;
+
+        muninn::TranslationCacheOptions options;
+        options.max_bytes = 3 * entry_bytes + entry_bytes / 2;
+        TranslationCache cache(options);
+        cache.insert("en", "es", 0, "text-0", "translation-0");
+        cache.insert("en", "es", 0, "text-1", "translation-1");
+        cache.insert("en", "es", 0, "text-2", "translation-2");
+        check(has(cache, "text-0"), "oldest entry touched");
+        cache.insert("en", "es", 0, "text-3", "translation-3");
+
+        check(!has(cache, "text-1"), "least recently used entry evicted");
+        check(has(cache, "text-0") && has(cache, "text-2") && has(cache, "text-3"), "recent entries kept");
+        auto stats = cache.stats();
+        check(stats.evictions == 1 && stats.entries == 3, "one eviction, three entries");
+        check(stats.bytes <= options.max_bytes, "within max_bytes");
+
+        cache.insert("en", "es", 0, "huge", std::string(options.max_bytes, 'x'));
+        check(!has(cache, "huge") && cache.stats().entries == 3, "entry larger than the budget is not cached");
+    }
+
+    std::cout << "[Persistence]\n";
+    {
+        muninn::TranslationCacheOptions options;
+        options.persist_path = persist.string();
+        {
+            TranslationCache cache(options);
+            cache.insert("en", "es", 0, "one", "uno");
+            cache.insert("en", "es", 0, "two", "dos");
+            cache.insert("en", "es", 0, "three", "tres");
+            has(cache, "one");  // Most recently used: one, three, two
+        }
+        check(fs::exists(persist), "saved on destruction");
+
+        TranslationCache reloaded(options);
+        check(reloaded.stats().entries == 3, "reloaded on construction");
+        check(has(reloaded, "one", "uno") && has(reloaded, "two", "dos") && has(reloaded, "three", "tres"),
+              "translations survive a reload");
+
+        // Recency survives too: with room for two, the least recent ("two") goes first
+        TranslationCache probe;
+        probe.insert("en", "es", 0, "three", "tres");
+        muninn::TranslationCacheOptions small;
+        small.max_bytes = 2 * probe.stats().bytes + 8;
+        TranslationCache bounded(small);
+        check(bounded.load(persist.string()), "load() into an existing cache");
+        check(!has(bounded, "two") && has(bounded, "one") && has(bounded, "three"), "recency order preserved");
+
+        check(!reloaded.load((scratch / "muninn_missing_cache.bin").string()) &&
+              !reloaded.get_last_error().empty(), "missing file reports an error");
+    }
+
+    std::cout << "[Corrupt files]\n";
+    {
+        // Valid header, then an entry claiming a ~4 GB key
+        fs::path corrupt = scratch / "muninn_test_translation_cache_corrupt.bin";
+        {
+            std::ofstream out(corrupt, std::ios::binary);
+            const uint32_t version = 1, count = 2, key_size = 0xFFFFFFF0u;
+            out.write("MTRC", 4);
+            out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+            out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            out.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+            out.write("abc", 3);
+        }
+        TranslationCache cache;
+        check(!cache.load(corrupt.string()) && cache.stats().entries == 0, "oversized field rejected");
+
+        // A good file cut short keeps the complete entries
+        {
+            TranslationCache source;
+            source.insert("en", "es", 0, "one", "uno");
+            source.insert("en", "es", 0, "two", "dos");
+            source.save(corrupt.string());
+        }
+        fs::resize_file(corrupt, fs::file_size(corrupt) - 2);
+        TranslationCache truncated;
+        check(!truncated.load(corrupt.string()) && truncated.stats().entries == 1 && has(truncated, "one"),
+              "truncated file keeps complete entries");
+        fs::remove(corrupt);
+    }
+
+    fs::remove(persist);
+
+    std::cout << "\n" << (g_failures == 0 ? "[PASS]" : "[FAIL]") << " " << g_failures << " failure(s)\n";
+    return g_failures == 0 ? 0 : 1;
+}